@@ -0,0 +1,39 @@
+#include "GridIndex.hpp"
+
+namespace complib {
+
+GridIndex::GridIndex() : grid(std::make_shared<UniformGrid>()) {}
+
+GridIndex::GridIndex( const idbb &fi ) : boxes_to_insert(fi) {
+  buildIndex();
+}
+
+void GridIndex::buildIndex(){
+  grid = std::make_shared<UniformGrid>(boxes_to_insert);
+}
+
+void GridIndex::insert( const unsigned int id, const BoundingBox &bb ){
+  insertDeferred(id, bb);
+  buildIndex();
+}
+
+void GridIndex::insertDeferred( const unsigned int id, const BoundingBox &bb ){
+  boxes_to_insert.emplace_back(id,bb);
+}
+
+std::vector<unsigned int> GridIndex::query( const MultiPolygon &mp ) const {
+  return query(mp.bbox());
+}
+
+std::vector<unsigned int> GridIndex::query( const BoundingBox &bb ) const {
+  std::vector<unsigned int> ret;
+  query(bb, ret);
+  return ret;
+}
+
+void GridIndex::query( const BoundingBox &bb, std::vector<unsigned int> &found ) const {
+  found.clear();
+  grid->query(bb, [&](const unsigned int id){ found.push_back(id); });
+}
+
+}
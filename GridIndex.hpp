@@ -0,0 +1,227 @@
+#ifndef _GridIndex_hpp_
+#define _GridIndex_hpp_
+
+#include "geom.hpp"
+#include "hilbert_rtree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace complib {
+
+///Immutable uniform grid over a set of boxes. Each box is listed in every cell
+///it covers. The cell size comes from the median box extent, so when the boxes
+///are of similar size each covers only a few cells and a query touches only a
+///few cells. This beats a tree on dense, evenly-sized units such as census
+///blocks. Any number of threads may query it at once.
+class UniformGrid {
+ public:
+  UniformGrid() = default;
+
+  explicit UniformGrid(const idbb &entries){
+    if(entries.empty())
+      return;
+    layOut(entries);
+    fillCells();
+  }
+
+  ///Whether a grid is a good fit for these boxes: there are enough of them to
+  ///be worth it, and with the cell size the grid would choose, they would be
+  ///listed in only a few cells each on average. Widely varying sizes (a few
+  ///huge boxes among many small ones) fail the second test.
+  static bool Suits(const idbb &entries){
+    if(entries.size()<min_entries)
+      return false;
+    UniformGrid shape;
+    shape.layOut(entries);
+    return shape.fits();
+  }
+
+  ///A grid over the boxes if they suit one (see Suits()), otherwise null. The
+  ///layout chosen to judge the fit is the one the grid is then filled in with,
+  ///so the boxes are copied and measured only once.
+  static std::shared_ptr<const UniformGrid> BuildIfSuited(const idbb &entries){
+    if(entries.size()<min_entries)
+      return nullptr;
+    auto grid = std::make_shared<UniformGrid>();
+    grid->layOut(entries);
+    if(!grid->fits())
+      return nullptr;
+    grid->fillCells();
+    return grid;
+  }
+
+  size_t size() const {
+    return boxes.size();
+  }
+
+  bool empty() const {
+    return boxes.empty();
+  }
+
+  ///Call `visit(id)` for the id of every box which intersects (or touches) `bb`.
+  ///A box listed in several of the cells the query covers is reported only
+  ///from the cell holding the lower-left corner of its overlap with the query.
+  template<class F>
+  void query(const BoundingBox &bb, F &&visit) const {
+    if(boxes.empty() || bb.min[0]>xmax || bb.max[0]<x0 || bb.min[1]>ymax || bb.max[1]<y0)
+      return;
+    const size_t cx0 = cellX(bb.min[0]);
+    const size_t cx1 = cellX(bb.max[0]);
+    const size_t cy0 = cellY(bb.min[1]);
+    const size_t cy1 = cellY(bb.max[1]);
+    for(size_t cy=cy0;cy<=cy1;cy++)
+    for(size_t cx=cx0;cx<=cx1;cx++){
+      const size_t c = cy*nx+cx;
+      for(size_t e=cell_offsets[c];e<cell_offsets[c+1];e++){
+        const auto &b = boxes[cell_entries[e]];
+        if(b.min[0]>bb.max[0] || bb.min[0]>b.max[0] || b.min[1]>bb.max[1] || bb.min[1]>b.max[1])
+          continue;
+        if(cellX(std::max(b.min[0],bb.min[0]))!=cx || cellY(std::max(b.min[1],bb.min[1]))!=cy)
+          continue;
+        visit(ids[cell_entries[e]]);
+      }
+    }
+  }
+
+ private:
+  std::vector<BoundingBox>  boxes;
+  std::vector<unsigned int> ids;
+  std::vector<size_t>       cell_offsets; ///< Entries of cell c are cell_entries[cell_offsets[c]] up to cell_entries[cell_offsets[c+1]]
+  std::vector<unsigned int> cell_entries; ///< Indices into boxes
+  double x0 = 0, y0 = 0, xmax = 0, ymax = 0;
+  double cell = 1;
+  size_t nx = 1, ny = 1;
+
+  static constexpr size_t min_entries = 1024;
+
+  //Take a copy of the boxes and choose the cells for them
+  void layOut(const idbb &entries){
+    boxes.reserve(entries.size());
+    ids.reserve(entries.size());
+    for(const auto &e: entries){
+      ids.push_back(e.first);
+      boxes.push_back(e.second);
+    }
+    chooseCells();
+  }
+
+  //Whether the boxes would be listed in few enough cells (see Suits())
+  bool fits() const {
+    size_t covered = 0;
+    for(const auto &bb: boxes)
+      covered += (cellX(bb.max[0])-cellX(bb.min[0])+1)*(cellY(bb.max[1])-cellY(bb.min[1])+1);
+    return covered<=6*boxes.size();
+  }
+
+  //Count the boxes in each cell, turn the counts into offsets, then fill in
+  void fillCells(){
+    cell_offsets.assign(nx*ny+1, 0);
+    for(const auto &bb: boxes)
+      forEachCell(bb, [&](const size_t c){ cell_offsets[c+1]++; });
+    for(size_t c=1;c<cell_offsets.size();c++)
+      cell_offsets[c] += cell_offsets[c-1];
+    cell_entries.resize(cell_offsets.back());
+    std::vector<size_t> fill(cell_offsets.begin(), cell_offsets.end()-1);
+    for(unsigned int i=0;i<boxes.size();i++)
+      forEachCell(boxes[i], [&](const size_t c){ cell_entries[fill[c]++] = i; });
+  }
+
+  //Set the extent, cell size, and cell counts from the boxes
+  void chooseCells(){
+    x0 = y0 = std::numeric_limits<double>::infinity();
+    xmax = ymax = -std::numeric_limits<double>::infinity();
+    std::vector<double> widths, heights;
+    widths.reserve(boxes.size());
+    heights.reserve(boxes.size());
+    for(const auto &bb: boxes){
+      x0   = std::min(x0,  bb.min[0]);
+      y0   = std::min(y0,  bb.min[1]);
+      xmax = std::max(xmax,bb.max[0]);
+      ymax = std::max(ymax,bb.max[1]);
+      widths.push_back(bb.max[0]-bb.min[0]);
+      heights.push_back(bb.max[1]-bb.min[1]);
+    }
+    std::nth_element(widths.begin(),  widths.begin() +widths.size()/2,  widths.end());
+    std::nth_element(heights.begin(), heights.begin()+heights.size()/2, heights.end());
+
+    const double width  = xmax-x0;
+    const double height = ymax-y0;
+    cell = std::max(widths[widths.size()/2], heights[heights.size()/2]);
+    //Degenerate (point-like) boxes: aim for about one box per cell instead
+    if(!(cell>0))
+      cell = std::max(width,height)/std::sqrt((double)boxes.size());
+    if(!(cell>0))
+      cell = 1;
+
+    //Don't let a sparse spread of boxes produce a vast, mostly-empty grid
+    const double max_cells = 4.0*boxes.size()+16;
+    double cells = std::ceil(width/cell+1e-9)*std::ceil(height/cell+1e-9);
+    if(cells>max_cells)
+      cell *= std::sqrt(cells/max_cells);
+
+    nx = std::max<size_t>(1, (size_t)std::ceil(width /cell+1e-9));
+    ny = std::max<size_t>(1, (size_t)std::ceil(height/cell+1e-9));
+  }
+
+  size_t cellX(const double x) const {
+    const double c = std::floor((x-x0)/cell);
+    return c<0 ? 0 : std::min(nx-1, (size_t)c);
+  }
+
+  size_t cellY(const double y) const {
+    const double c = std::floor((y-y0)/cell);
+    return c<0 ? 0 : std::min(ny-1, (size_t)c);
+  }
+
+  template<class F>
+  void forEachCell(const BoundingBox &bb, F &&f) const {
+    const size_t cx1 = cellX(bb.max[0]);
+    const size_t cy1 = cellY(bb.max[1]);
+    for(size_t cy=cellY(bb.min[1]);cy<=cy1;cy++)
+    for(size_t cx=cellX(bb.min[0]);cx<=cx1;cx++)
+      f(cy*nx+cx);
+  }
+};
+
+
+
+///Spatial index with the same interface as SpIndex, always backed by a
+///uniform grid. SpIndex switches to a grid by itself when the boxes suit one;
+///this class is for when a grid is wanted regardless.
+class GridIndex {
+ private:
+  std::shared_ptr<const UniformGrid> grid;
+  idbb boxes_to_insert;
+
+ public:
+  GridIndex();
+  explicit GridIndex( const idbb &fi );
+
+  ///Build the index from all the boxes inserted so far
+  void buildIndex();
+
+  ///Add a box and rebuild the index. When adding many boxes it is much faster
+  ///to use insertDeferred() followed by a single buildIndex().
+  void insert( const unsigned int id, const BoundingBox &bb );
+  void insertDeferred( const unsigned int id, const BoundingBox &bb );
+
+  std::vector<unsigned int> query( const BoundingBox &bb ) const;
+  std::vector<unsigned int> query( const MultiPolygon &mp ) const;
+
+  ///Call `visit(id)` for each box intersecting `bb`. No memory is allocated.
+  template<class F>
+  void query( const BoundingBox &bb, F &&visit ) const {
+    grid->query(bb, std::forward<F>(visit));
+  }
+
+  ///Replace the contents of `found` with the ids of the boxes intersecting `bb`
+  void query( const BoundingBox &bb, std::vector<unsigned int> &found ) const;
+};
+
+}
+
+#endif
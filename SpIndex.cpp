@@ -1,169 +1,369 @@
 #include "SpIndex.hpp"
-#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
 #include <stdexcept>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #define COMPLIB_HAVE_MMAP
+#else
+  #include <atomic>
+  #include <functional>
+  #include <thread>
+#endif
 
 namespace complib {
 
-SpatialIndex::Region BoundingBoxToRegion( const BoundingBox &rect ){
-  const double pt1[2] = { rect.xmin(), rect.ymin() };
-  const double pt2[2] = { rect.xmax(), rect.ymax() };
-  return SpatialIndex::Region( pt1, pt2, 2 );
-}
-
-class ObjVisitor : public SpatialIndex::IVisitor {
- private:
-  std::vector<unsigned int>& mList;
+//Indices may be built from many threads at once, so the directory is only
+//touched under the lock
+static std::string spindex_cache_dir;
+static std::mutex  spindex_cache_dir_mutex;
 
- public:
-  explicit ObjVisitor( std::vector<unsigned int> &list ) : mList( list ) {}
-
-  void visitNode( const SpatialIndex::INode &n ) override {}
+void SetSpIndexCacheDir(const std::string &dir){
+  std::lock_guard<std::mutex> lock(spindex_cache_dir_mutex);
+  spindex_cache_dir = dir;
+}
 
-  void visitData( const SpatialIndex::IData &d ) override {
-    mList.emplace_back( d.getIdentifier() );
+std::string GetSpIndexCacheDir(){
+  std::lock_guard<std::mutex> lock(spindex_cache_dir_mutex);
+  return spindex_cache_dir;
 }
 
-  void visitData( std::vector<const SpatialIndex::IData *> &v ) override {}
-};
+uint64_t HashBoxes(const idbb &boxes){
+  //FNV-1a
+  uint64_t hash = 14695981039346656037ull;
+  const auto add = [&](const void *data, const size_t len){
+    const unsigned char *bytes = static_cast<const unsigned char*>(data);
+    for(size_t i=0;i<len;i++){
+      hash ^= bytes[i];
+      hash *= 1099511628211ull;
+    }
+  };
+  for(const auto &b: boxes){
+    add(&b.first,      sizeof(b.first));
+    add(b.second.min,  sizeof(b.second.min));
+    add(b.second.max,  sizeof(b.second.max));
+  }
+  return hash;
+}
 
 
 
-class IteratorDataStream : public SpatialIndex::IDataStream {
- private:
-  const idbb& mFi;
-  idbb::const_iterator iter;
-  bool started = false;
-  SpatialIndex::RTree::Data *mNextData = nullptr;
+//On-disk layout: this header, then the level ends, the node boxes, and the
+//node ids, exactly as they are laid out in memory. After them come the boxes
+//the tree was built from and their ids, in the order they were given, so that
+//a cached file can be checked against the boxes it is meant to index.
+class SpIndexFileHeader {
+ public:
+  char     magic[8];
+  uint32_t version;
+  uint32_t node_size;
+  uint64_t geometry_hash;
+  uint64_t num_nodes;
+  uint64_t num_levels;
+  uint32_t byte_order;
+  uint32_t padding;
+};
 
-  void readNextEntry() {
-    if(iter==mFi.end()){
-      mNextData = nullptr;
-      return;
-    }
-    auto r = BoundingBoxToRegion(iter->second);
-    mNextData = new SpatialIndex::RTree::Data(
-      0,
-      nullptr,
-      r,
-      iter->first
-    );
-    iter++;
+static const char     SPINDEX_MAGIC[8]   = {'C','L','S','P','I','D','X','\0'};
+static const uint32_t SPINDEX_VERSION    = 2;
+static const uint32_t SPINDEX_BYTE_ORDER = 0x01020304;
+
+static_assert(sizeof(SpIndexFileHeader)==48, "Unexpected SpIndex file header padding!");
+static_assert(sizeof(BoundingBox)==4*sizeof(double), "Unexpected BoundingBox padding!");
+
+//Create and open a new file, next to `filename`, whose name no other writer in
+//this or any other process will be using. Returns null on failure.
+static std::FILE* OpenUniqueTempFile(const std::string &filename, std::string &tmpname){
+#ifdef COMPLIB_HAVE_MMAP
+  std::vector<char> name(filename.begin(), filename.end());
+  const std::string suffix = ".tmp.XXXXXX";
+  name.insert(name.end(), suffix.begin(), suffix.end());
+  name.push_back('\0');
+  const int fd = mkstemp(name.data());
+  if(fd<0)
+    return nullptr;
+  tmpname = name.data();
+  //mkstemp() makes the file private; an index is no more secret than the
+  //geometry it was built from
+  fchmod(fd, 0644);
+  std::FILE *fp = fdopen(fd, "wb");
+  if(!fp){
+    close(fd);
+    std::remove(tmpname.c_str());
   }
-
- public:
-  explicit IteratorDataStream( const idbb& fi ) : mFi( fi ) {
-    iter = mFi.begin();
-    readNextEntry();
+  return fp;
+#else
+  //Distinguish writers by thread and by a per-process counter, and let "x"
+  //refuse names which are already taken (say, by another process)
+  static std::atomic<unsigned long> counter(0);
+  const auto thread_hash = std::hash<std::thread::id>()(std::this_thread::get_id());
+  for(int attempt=0;attempt<100;attempt++){
+    tmpname = filename + ".tmp." + std::to_string(thread_hash) + "." + std::to_string(counter++);
+    std::FILE *fp = std::fopen(tmpname.c_str(), "wbx");
+    if(fp)
+      return fp;
   }
+  return nullptr;
+#endif
+}
 
-  ~IteratorDataStream() {
-    delete mNextData;
+static void WriteIndexFile(const PackedHilbertRTree &tree, const idbb &sources, const std::string &filename){
+  if(sources.size()!=tree.size())
+    throw std::runtime_error("Spatial index does not hold the boxes it is being saved with!");
+
+  SpIndexFileHeader hdr;
+  std::memcpy(hdr.magic, SPINDEX_MAGIC, sizeof(hdr.magic));
+  hdr.version       = SPINDEX_VERSION;
+  hdr.node_size     = PackedHilbertRTree::node_size;
+  hdr.geometry_hash = HashBoxes(sources);
+  hdr.num_nodes     = tree.nodeCount();
+  hdr.num_levels    = tree.levelCount();
+  hdr.byte_order    = SPINDEX_BYTE_ORDER;
+  hdr.padding       = 0;
+
+  //Write to a temporary file of our own and move it into place, so that a
+  //reader never sees a partial index and writers racing to save the same index
+  //never write into the same file
+  std::string tmpname;
+  std::FILE *fout = OpenUniqueTempFile(filename, tmpname);
+  if(!fout)
+    throw std::runtime_error("Could not create a temporary file to save spatial index '" + filename + "'!");
+  bool ok = true;
+  ok = ok && std::fwrite(&hdr, sizeof(hdr), 1, fout)==1;
+  ok = ok && std::fwrite(tree.levelEnds(), sizeof(uint64_t),     tree.levelCount(), fout)==tree.levelCount();
+  ok = ok && std::fwrite(tree.nodeBoxes(), sizeof(BoundingBox),  tree.nodeCount(),  fout)==tree.nodeCount();
+  ok = ok && std::fwrite(tree.nodeIds(),   sizeof(unsigned int), tree.nodeCount(),  fout)==tree.nodeCount();
+  for(const auto &b: sources)
+    ok = ok && std::fwrite(&b.second, sizeof(BoundingBox),  1, fout)==1;
+  for(const auto &b: sources)
+    ok = ok && std::fwrite(&b.first,  sizeof(unsigned int), 1, fout)==1;
+  ok = (std::fclose(fout)==0) && ok;
+  if(!ok){
+    std::remove(tmpname.c_str());
+    throw std::runtime_error("Failed to write spatial index to '" + tmpname + "'!");
   }
-
-  SpatialIndex::IData* getNext() override {
-    SpatialIndex::RTree::Data *ret = mNextData;
-    mNextData = nullptr;
-    readNextEntry();
-    return ret;
+  if(std::rename(tmpname.c_str(), filename.c_str())!=0){
+    std::remove(tmpname.c_str());
+    throw std::runtime_error("Could not move spatial index into place at '" + filename + "'!");
   }
+}
 
-  bool hasNext() override {
-    return iter != mFi.end();
+//Whether the levels and parent ids are exactly those PackedHilbertRTree builds
+//from level_ends[0] boxes: every level above the leaves has one node for each
+//node_size nodes of the level below, ending in a single root, and parent j of
+//a level points at child j*node_size of the level below. Queries then only
+//ever index nodes which exist, and need no more stack than the tree is built
+//for. Only the parents' ids are read, not the leaves'.
+static bool ValidTreeLayout(const uint64_t *level_ends, const uint64_t num_levels, const unsigned int *ids, const uint64_t num_nodes){
+  if(num_levels==0)
+    return num_nodes==0;
+  uint64_t begin = 0;
+  uint64_t end   = level_ends[0];
+  if(end==0 || end>num_nodes)
+    return false;
+  for(uint64_t l=1;l<num_levels;l++){
+    if(end-begin<=1)
+      return false; //The root was below this level
+    const uint64_t parents = (end-begin+PackedHilbertRTree::node_size-1)/PackedHilbertRTree::node_size;
+    if(level_ends[l]!=end+parents || level_ends[l]>num_nodes)
+      return false;
+    for(uint64_t p=0;p<parents;p++)
+      if(ids[end+p]!=begin+p*PackedHilbertRTree::node_size)
+        return false;
+    begin = end;
+    end   = level_ends[l];
   }
+  return end-begin==1 && end==num_nodes;
+}
 
-  uint32_t size() override {
-    throw std::runtime_error("IteratorDataStream::size() not available!");
+//Map an index file into memory and check that it is intact. If `expected` is
+//given, the file must have been built from exactly those boxes, in that order.
+static std::shared_ptr<const PackedHilbertRTree> MapIndexFile(const std::string &filename, const idbb *expected){
+  std::shared_ptr<const void> mem;
+  size_t len = 0;
+
+#ifdef COMPLIB_HAVE_MMAP
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if(fd<0)
+    throw std::runtime_error("Could not open spatial index '" + filename + "'!");
+  struct stat st;
+  if(fstat(fd,&st)!=0 || st.st_size<(off_t)sizeof(SpIndexFileHeader)){
+    close(fd);
+    throw std::runtime_error("Spatial index '" + filename + "' is truncated!");
   }
-
-  void rewind() override { 
-    throw std::runtime_error("IteratorDataStream::size() not available!");
+  len = st.st_size;
+  void *addr = mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(addr==MAP_FAILED)
+    throw std::runtime_error("Could not map spatial index '" + filename + "'!");
+  mem = std::shared_ptr<const void>(addr, [len](const void *p){ munmap(const_cast<void*>(p), len); });
+#else
+  //Without mmap, read the file into memory once
+  std::ifstream fin(filename, std::ios::binary | std::ios::ate);
+  if(!fin.good())
+    throw std::runtime_error("Could not open spatial index '" + filename + "'!");
+  len = fin.tellg();
+  fin.seekg(0);
+  //Allocated as doubles so the boxes are aligned
+  std::shared_ptr<double> buf(new double[len/sizeof(double)+1], std::default_delete<double[]>());
+  fin.read(reinterpret_cast<char*>(buf.get()), len);
+  if(!fin.good() || len<sizeof(SpIndexFileHeader))
+    throw std::runtime_error("Spatial index '" + filename + "' is truncated!");
+  mem = buf;
+#endif
+
+  const char *base = static_cast<const char*>(mem.get());
+  SpIndexFileHeader hdr;
+  std::memcpy(&hdr, base, sizeof(hdr));
+  if(std::memcmp(hdr.magic, SPINDEX_MAGIC, sizeof(hdr.magic))!=0)
+    throw std::runtime_error("'" + filename + "' is not a spatial index!");
+  if(hdr.version!=SPINDEX_VERSION || hdr.node_size!=PackedHilbertRTree::node_size || hdr.byte_order!=SPINDEX_BYTE_ORDER)
+    throw std::runtime_error("Spatial index '" + filename + "' was written by an incompatible version!");
+
+  const auto corrupt = [&](){
+    return std::runtime_error("Spatial index '" + filename + "' is corrupt!");
+  };
+
+  //Bound the counts by what could fit in the file before using them, so that
+  //the offsets below can't overflow. There is one source box for each leaf.
+  if(hdr.num_levels>PackedHilbertRTree::max_levels)
+    throw corrupt();
+  const size_t levels_off = sizeof(hdr);
+  const size_t boxes_off  = levels_off + hdr.num_levels*sizeof(uint64_t);
+  if(boxes_off>len)
+    throw corrupt();
+  const uint64_t *level_ends = reinterpret_cast<const uint64_t*>(base+levels_off);
+  const uint64_t  num_leaves = hdr.num_levels>0 ? level_ends[0] : 0;
+  if(hdr.num_nodes>(len-sizeof(hdr))/(sizeof(BoundingBox)+sizeof(unsigned int)) || num_leaves>hdr.num_nodes)
+    throw corrupt();
+  const size_t ids_off          = boxes_off        + hdr.num_nodes*sizeof(BoundingBox);
+  const size_t source_boxes_off = ids_off          + hdr.num_nodes*sizeof(unsigned int);
+  const size_t source_ids_off   = source_boxes_off + num_leaves*sizeof(BoundingBox);
+  const size_t end_off          = source_ids_off   + num_leaves*sizeof(unsigned int);
+  if(end_off!=len || (hdr.num_nodes>0)!=(hdr.num_levels>0))
+    throw corrupt();
+
+  const unsigned int *ids = reinterpret_cast<const unsigned int*>(base+ids_off);
+  if(!ValidTreeLayout(level_ends, hdr.num_levels, ids, hdr.num_nodes))
+    throw corrupt();
+
+  //Compare the boxes the file was built from with those it is wanted for, bit
+  //for bit, so that neither a stale file nor a collision of the hashes which
+  //name cached files gets through
+  const auto different = [&](){
+    return std::runtime_error("Spatial index '" + filename + "' was built from different geometry!");
+  };
+  if(expected){
+    if(expected->size()!=num_leaves)
+      throw different();
+    for(size_t i=0;i<num_leaves;i++){
+      const auto &e = (*expected)[i];
+      if(std::memcmp(base+source_boxes_off+i*sizeof(BoundingBox), &e.second, sizeof(BoundingBox))!=0)
+        throw different();
+      if(std::memcmp(base+source_ids_off+i*sizeof(unsigned int), &e.first, sizeof(unsigned int))!=0)
+        throw different();
+    }
   }
-};
 
+  return std::make_shared<const PackedHilbertRTree>(
+    reinterpret_cast<const BoundingBox*>(base+boxes_off),
+    ids,
+    hdr.num_nodes,
+    level_ends,
+    hdr.num_levels,
+    mem
+  );
+}
 
-class SpIndexData {
- public:
-  SpatialIndex::IStorageManager *mStorage = nullptr;
-  SpatialIndex::ISpatialIndex *mRTree     = nullptr;
 
-  SpIndexData() {
-    initTree();
-  }
 
-  explicit SpIndexData( const idbb &fi){
-    IteratorDataStream fids( fi );
-    initTree( &fids );
-  }
+SpIndex::SpIndex() : tree(std::make_shared<PackedHilbertRTree>()) {}
 
-  ~SpIndexData() {
-    delete mRTree;
-    delete mStorage;
-  }
+SpIndex::SpIndex( const idbb &fi) : boxes_to_insert(fi) {
+  buildIndex();
+}
 
-  SpIndexData &operator=( const SpIndexData &rh ) = delete;
-
-  void initTree( SpatialIndex::IDataStream *inputStream = nullptr ){
-    // for now only memory manager
-    mStorage = SpatialIndex::StorageManager::createNewMemoryStorageManager();
-
-    // R-Tree parameters
-    const double fillFactor                         = 0.7;
-    const unsigned long indexCapacity               = 10;
-    const unsigned long leafCapacity                = 10;
-    const unsigned long dimension                   = 2;
-    const SpatialIndex::RTree::RTreeVariant variant = SpatialIndex::RTree::RV_RSTAR;
-
-    // create R-tree
-    SpatialIndex::id_type indexId;
-
-    if ( inputStream )
-      mRTree = SpatialIndex::RTree::createAndBulkLoadNewRTree(
-        SpatialIndex::RTree::BLM_STR, *inputStream, *mStorage, fillFactor, indexCapacity,
-               leafCapacity, dimension, variant, indexId );
-    else
-      mRTree = SpatialIndex::RTree::createNewRTree( *mStorage, fillFactor, indexCapacity,
-                                      leafCapacity, dimension, variant, indexId );
+void SpIndex::buildIndex(){
+  grid = UniformGrid::BuildIfSuited(boxes_to_insert);
+  if(grid){
+    tree = std::make_shared<PackedHilbertRTree>();
+    return;
   }
-};
 
+  const std::string cache_dir = GetSpIndexCacheDir();
+  if(cache_dir.empty()){
+    tree = std::make_shared<PackedHilbertRTree>(boxes_to_insert);
+    return;
+  }
 
+  const uint64_t hash = HashBoxes(boxes_to_insert);
+  char hashstr[17];
+  std::snprintf(hashstr, sizeof(hashstr), "%016llx", (unsigned long long)hash);
+  const std::string filename = cache_dir + "/spindex-" + hashstr + ".bin";
 
+  //The cache is only an optimisation: if it can't be read or written, carry
+  //on with an index built in memory
+  try {
+    tree = MapIndexFile(filename, &boxes_to_insert);
+    return;
+  } catch (const std::runtime_error &) {}
 
+  auto built = std::make_shared<PackedHilbertRTree>(boxes_to_insert);
+  try {
+    WriteIndexFile(*built, boxes_to_insert, filename);
+  } catch (const std::runtime_error &) {}
+  tree = built;
+}
 
+bool SpIndex::usesGrid() const {
+  return (bool)grid;
+}
 
-SpIndex::SpIndex(){
-  d.reset(new SpIndexData);
+void SpIndex::save( const std::string &filename ) const {
+  //Only trees are saved. A grid's boxes are all still in boxes_to_insert.
+  const auto sources = entries();
+  if(grid)
+    WriteIndexFile(PackedHilbertRTree(sources), sources, filename);
+  else
+    WriteIndexFile(*tree, sources, filename);
 }
 
-SpIndex::SpIndex( const idbb &fi){
-  d.reset(new SpIndexData( fi ) );
+SpIndex SpIndex::load( const std::string &filename ){
+  SpIndex sp;
+  sp.tree = MapIndexFile(filename, nullptr);
+  return sp;
 }
 
-void SpIndex::buildIndex(){
-  d.reset(new SpIndexData(boxes_to_insert));
+idbb SpIndex::entries() const {
+  if(!boxes_to_insert.empty() || tree->empty())
+    return boxes_to_insert;
+  idbb ret;
+  ret.reserve(tree->size());
+  for(size_t i=0;i<tree->size();i++)
+    ret.emplace_back(tree->nodeIds()[i], tree->nodeBoxes()[i]);
+  return ret;
 }
 
-SpIndex& SpIndex::operator=( const SpIndex &other ){
-  if ( this != &other )
-    d = other.d;
-  return *this;
+void SpIndex::recoverBoxes(){
+  //The leaves hold every box
+  if(boxes_to_insert.empty())
+    boxes_to_insert = entries();
 }
 
 void SpIndex::insert( unsigned int id, const BoundingBox &rect ){
-  SpatialIndex::Region r( BoundingBoxToRegion( rect ) );
-
-  try {
-    d->mRTree->insertData( 0, nullptr, r, id );
-  } catch ( Tools::Exception &e ) {
-    throw std::runtime_error(std::string("libspatialindex tools exception: ")+e.what() );
-  } catch ( const std::exception &e ) {
-    throw std::runtime_error(std::string("std::exception in SpIndex: ")+e.what());
-  } catch ( ... ) {
-    throw std::runtime_error(std::string("Unknown libspatialindex exception caught!"));
-}
+  insertDeferred(id, rect);
+  buildIndex();
 }
 
 void SpIndex::insertDeferred( const unsigned int id, const BoundingBox &bb ){
+  recoverBoxes();
   boxes_to_insert.emplace_back(id,bb);
 }
 
@@ -172,19 +372,119 @@ std::vector<unsigned int> SpIndex::query( const MultiPolygon &mp ) const {
 }
 
 std::vector<unsigned int> SpIndex::query( const BoundingBox &rect ) const {
-  const SpatialIndex::Region r( BoundingBoxToRegion(rect) );
-
-  //Object that will show us what results we've found
   std::vector<unsigned int> ret;
-  ObjVisitor visitor(ret);
+  query(rect, ret);
+  return ret;
+}
+
+void SpIndex::query( const BoundingBox &bb, std::vector<unsigned int> &found ) const {
+  found.clear();
+  query(bb, [&](const unsigned int id){ found.push_back(id); });
+}
+
+SpIndexResults SpIndex::queryBatch( const std::vector<BoundingBox> &bbs ) const {
+  const auto order = HilbertOrder(bbs.size(), [&](const size_t i) -> const BoundingBox& {
+    return bbs[i];
+  });
+
+  //Count each query's results, turn the counts into offsets, and then fill in
+  //the ids. Traversing twice is cheaper than gathering results into temporary
+  //per-query storage, and lets each thread write straight into its own slots.
+  SpIndexResults res;
+  res.offsets.assign(bbs.size()+1, 0);
+
+  #pragma omp parallel for schedule(dynamic,64)
+  for(unsigned int oi=0;oi<order.size();oi++){
+    const auto q = order[oi];
+    size_t count = 0;
+    query(bbs[q], [&](const unsigned int){ count++; });
+    res.offsets[q+1] = count;
+  }
+
+  for(size_t i=1;i<res.offsets.size();i++)
+    res.offsets[i] += res.offsets[i-1];
+  res.ids.resize(res.offsets.back());
 
-  #pragma omp critical
-  d->mRTree->intersectsWithQuery( r, visitor );
+  #pragma omp parallel for schedule(dynamic,64)
+  for(unsigned int oi=0;oi<order.size();oi++){
+    const auto q = order[oi];
+    unsigned int *out = res.ids.data()+res.offsets[q];
+    query(bbs[q], [&](const unsigned int id){ *out++ = id; });
+  }
+
+  return res;
+}
+
+SpIndexResults SpIndex::queryBatch( const GeoCollection &gc ) const {
+  std::vector<BoundingBox> bbs;
+  bbs.reserve(gc.size());
+  for(const auto &mp: gc)
+    bbs.push_back(mp.bbox());
+  return queryBatch(bbs);
+}
+
+std::vector< std::pair<unsigned int, unsigned int> > SpatialJoin(const SpIndex &a, const SpIndex &b){
+  typedef std::vector< std::pair<unsigned int, unsigned int> > pairs_t;
+
+  if(a.grid || b.grid){
+    //Grids have no hierarchy to descend, so look up each of a's boxes in b
+    const auto aboxes = a.entries();
+    const size_t chunk = 1024;
+    std::vector<pairs_t> found((aboxes.size()+chunk-1)/chunk);
+    #pragma omp parallel for schedule(dynamic)
+    for(unsigned int c=0;c<found.size();c++)
+    for(size_t i=c*chunk;i<std::min(aboxes.size(),(c+1)*chunk);i++)
+      b.query(aboxes[i].second, [&](const unsigned int idb){ found[c].emplace_back(aboxes[i].first,idb); });
+
+    pairs_t ret;
+    for(const auto &f: found)
+      ret.insert(ret.end(), f.begin(), f.end());
+    std::sort(ret.begin(), ret.end());
+    return ret;
+  }
 
-  //Copy results    
+  //Enough independent pieces of work to keep every thread busy, even though
+  //they vary greatly in size
+  const auto frontier = PackedHilbertRTree::joinFrontier(*a.tree, *b.tree, 1024);
+
+  std::vector<pairs_t> found(frontier.size());
+  #pragma omp parallel for schedule(dynamic)
+  for(unsigned int i=0;i<frontier.size();i++)
+    PackedHilbertRTree::join(
+      *a.tree, frontier[i].first,
+      *b.tree, frontier[i].second,
+      [&](const unsigned int ida, const unsigned int idb){ found[i].emplace_back(ida,idb); }
+    );
+
+  size_t total = 0;
+  for(const auto &f: found)
+    total += f.size();
+
+  pairs_t ret;
+  ret.reserve(total);
+  for(const auto &f: found)
+    ret.insert(ret.end(), f.begin(), f.end());
+  std::sort(ret.begin(), ret.end());
   return ret;
 }
 
+std::vector< std::pair<unsigned int, unsigned int> > SpatialJoin(const GeoCollection &a, const GeoCollection &b){
+  SpIndex aidx;
+  for(unsigned int i=0;i<a.size();i++)
+    AddToSpIndex(a.at(i), aidx, i, 0.);
+  aidx.buildIndex();
+
+  if(&a==&b)
+    return SpatialJoin(aidx, aidx);
+
+  SpIndex bidx;
+  for(unsigned int i=0;i<b.size();i++)
+    AddToSpIndex(b.at(i), bidx, i, 0.);
+  bidx.buildIndex();
+
+  return SpatialJoin(aidx, bidx);
+}
+
 void AddToSpIndex(const MultiPolygon &mp, SpIndex &sp, const unsigned int id, const double expandby){
   auto bb = mp.bbox();
   bb.expand(expandby);
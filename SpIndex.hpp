@@ -2,53 +2,125 @@
 #define _SpIndex_hpp_
 
 #include "geom.hpp"
-#include "lib/spatialindex/SpatialIndex.h"
+#include "hilbert_rtree.hpp"
+#include "GridIndex.hpp"
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace complib {
 
-class SpIndexData;
+///Results of many queries in compressed sparse row form: the ids found by query
+///`i` are `ids[offsets[i]]` up to (but not including) `ids[offsets[i+1]]`
+class SpIndexResults {
+ public:
+  std::vector<size_t>       offsets;
+  std::vector<unsigned int> ids;
+
+  ///Number of queries
+  size_t size() const { return offsets.empty() ? 0 : offsets.size()-1; }
+  const unsigned int* begin(const size_t i) const { return ids.data()+offsets[i];   }
+  const unsigned int* end  (const size_t i) const { return ids.data()+offsets[i+1]; }
+};
 
-typedef std::vector< std::pair<unsigned int, BoundingBox> > idbb;
-  
 class SpIndex {
  private:
-  std::shared_ptr<SpIndexData> d;
+  std::shared_ptr<const PackedHilbertRTree> tree;
+  std::shared_ptr<const UniformGrid>        grid; ///< Used instead of the tree when the boxes suit it
   idbb boxes_to_insert;
 
-  static constexpr double prop_fill_factor    = 0.7;
-  static constexpr int    prop_index_capacity = 100;
-  static constexpr int    prop_leaf_capacity  = 100;
-  static constexpr int    prop_dimension      = 2;
-  static constexpr auto   prop_tree_variant   = SpatialIndex::RTree::RV_RSTAR;
+  //An index loaded from a file has no list of boxes until one is needed
+  void recoverBoxes();
+  //All of the indexed boxes
+  idbb entries() const;
 
  public:
     /* creation of spatial index */
 
-  SpIndex();
+    SpIndex();
     explicit SpIndex ( const idbb &fi );
 
+    ///Build the index from all the boxes inserted so far. Many boxes of
+    ///similar size (see UniformGrid::Suits) go into a uniform grid; anything
+    ///else goes into an R-tree. If a cache directory has been set (see
+    ///SetSpIndexCacheDir) and it holds an R-tree built from exactly these
+    ///boxes, that tree is mapped into memory instead; otherwise the new tree is
+    ///saved there for next time. Cached files keep a copy of the boxes they were
+    ///built from, which must match the boxes being indexed bit for bit. Grids
+    ///are cheap enough to always rebuild.
     void buildIndex();
 
-    SpIndex& operator=( const SpIndex &other );
+    ///Whether the index chose a grid over a tree at the last buildIndex()
+    bool usesGrid() const;
+
+    ///Write the index to a file which load() can map back into memory
+    void save( const std::string &filename ) const;
+    ///Map an index written by save() into memory and query it in place.
+    ///Throws if the file is unreadable, from a different version of the
+    ///library, or corrupt. Boxes inserted afterwards are added to those in the
+    ///file.
+    static SpIndex load( const std::string &filename );
 
     /* operations */
 
+    ///Add a box and rebuild the index. When adding many boxes it is much faster
+    ///to use insertDeferred() followed by a single buildIndex().
     void insert( const unsigned int id, const BoundingBox &bb );
     void insertDeferred( const unsigned int id, const BoundingBox &bb );
 
     /* queries */
 
+    //Queries only read the index, so they may be run from many threads at once
     std::vector<unsigned int> query( const BoundingBox &bb ) const;
     std::vector<unsigned int> query( const MultiPolygon &mp ) const;
 
-
-//    friend class SpIndexData; // for access to featureInfo()
+    ///Call `visit(id)` for each box intersecting `bb`. No memory is allocated.
+    template<class F>
+    void query( const BoundingBox &bb, F &&visit ) const {
+      if(grid)
+        grid->query(bb, visit);
+      else
+        tree->query(bb, visit);
+    }
+
+    ///Replace the contents of `found` with the ids of the boxes intersecting
+    ///`bb`. Reusing `found` between queries avoids reallocating it.
+    void query( const BoundingBox &bb, std::vector<unsigned int> &found ) const;
+
+    ///Run many queries at once, in parallel. The queries are visited in
+    ///Hilbert order so that neighbouring queries share the parts of the tree
+    ///they touch. Results are returned in the order of `bbs`.
+    SpIndexResults queryBatch( const std::vector<BoundingBox> &bbs ) const;
+    ///Query with the bounding box of each of the collection's multipolygons
+    SpIndexResults queryBatch( const GeoCollection &gc ) const;
+
+    friend std::vector< std::pair<unsigned int, unsigned int> > SpatialJoin(const SpIndex &a, const SpIndex &b);
 };
 
+///All pairs (id_a, id_b) of boxes, one from each index, which intersect. When
+///both indices are trees they are traversed together and independent pairs of
+///subtrees are joined in parallel; otherwise each box of `a` is looked up in
+///`b` in parallel. The pairs are sorted.
+std::vector< std::pair<unsigned int, unsigned int> > SpatialJoin(const SpIndex &a, const SpIndex &b);
+
+///All pairs (i,j) such that the bounding boxes of `a[i]` and `b[j]` intersect.
+///Passing the same collection twice gives a self-join (including i==j).
+std::vector< std::pair<unsigned int, unsigned int> > SpatialJoin(const GeoCollection &a, const GeoCollection &b);
+
 void AddToSpIndex(const MultiPolygon &mp, SpIndex &sp, const unsigned int id, const double expandby);
 
+///Directory in which built indices are saved, keyed by a hash of the boxes they
+///hold, so that later runs over the same geometry can map them instead of
+///rebuilding them. An empty string (the default) disables the cache. May be
+///called at any time: an index being built meanwhile uses either directory.
+void SetSpIndexCacheDir(const std::string &dir);
+std::string GetSpIndexCacheDir();
+
+///Hash of the ids and boxes, which identifies the index built from them
+uint64_t HashBoxes(const idbb &boxes);
+
 }
 
 #endif
-
@@ -3,7 +3,9 @@
 #include <cmath>
 #include <vector>
 #include <stdexcept>
+#include <exception>
 #include <unordered_map>
+#include <atomic>
 #include "lib/clipper.hpp"
 
 #include <sstream>  //TODO
@@ -13,9 +15,23 @@ namespace complib {
 
 namespace cl = ClipperLib;
 
-double ScoreConvexHullPTB(const MultiPolygon &mp, const MultiPolygon &border){
-  const double area      = areaIncludingHoles(mp);
-  const double hull_area = IntersectionArea(mp.getHull(),border);
+double ScoreConvexHullPTB(const MultiPolygon &mp, const PreparedPolygon &border){
+  const double area = areaIncludingHoles(mp);
+  const auto  &hull = mp.getHull();
+
+  //Most hulls lie wholly within the border and need no clipping
+  double hull_area;
+  switch(border.classify(hull)){
+    case PreparedPolygon::Overlap::Inside:
+      hull_area = hull.summary().area;
+      break;
+    case PreparedPolygon::Overlap::Outside:
+      hull_area = 0;
+      break;
+    default:
+      hull_area = ConvexIntersectionArea(hull, border.geometry());
+  }
+
   double ratio = area/hull_area;
   if(ratio>1)
     ratio = 1;
@@ -24,9 +40,9 @@ double ScoreConvexHullPTB(const MultiPolygon &mp, const MultiPolygon &border){
 
 
 
-double ScoreReockPTB(const MultiPolygon &mp, const MultiPolygon &border){
-  const auto   circle = GetBoundingCircle(mp);
-  const auto   iarea  = IntersectionArea(circle, border);
+double ScoreReockPTB(const MultiPolygon &mp, const PreparedPolygon &border){
+  const auto   circle = MinimumEnclosingCircle(mp);
+  const double iarea  = IntersectionArea(circle, border);
   const double area   = areaIncludingHoles(mp);
 
   double ratio = area/iarea;
@@ -86,8 +102,8 @@ cl::Paths GetClipperRing(const cl::Paths &unit, const int pad_amount){
   return ring;
 }
 
-double ScoreBorderAreaUncertainty(const MultiPolygon &mp, const MultiPolygon &border){
-  static int ringnum=0;
+double ScoreBorderAreaUncertainty(const MultiPolygon &mp, const PreparedPolygon &border){
+  static std::atomic<int> ringnum(0);
   ringnum++;
   //Amount by which we will grow the subunit
   const int pad_amount = 1000; //metres
@@ -99,7 +115,7 @@ double ScoreBorderAreaUncertainty(const MultiPolygon &mp, const MultiPolygon &bo
 
   //Get paths for both the subunit and its superunit
   const auto paths_mp = ConvertToClipper(mp,false);
-  const auto paths_bo = ConvertToClipper(border,false);
+  const auto &paths_bo = border.clipperPaths();
 
   //std::cerr<<ringnum<<",pathmp,\""<<OutputPaths(paths_mp)<<"\""<<std::endl;
   //std::cerr<<ringnum<<",pathbo,\""<<OutputPaths(paths_bo)<<"\""<<std::endl;
@@ -183,14 +199,16 @@ void CalculateListOfBoundedScores(
     score_list = getListOfBoundedScores();
 
 
+  //Find the superunit each subunit will be scored against. Each superunit is
+  //prepared once, up front, rather than once per subunit.
+  std::vector<const PreparedPolygon *> sub_parent(subunits.size(), nullptr);
+  std::vector<PreparedPolygon> prepared;
+
   if(join_on.empty() || superunits.size()==1){
 
-    for(auto& sub: subunits){
-      for(const auto &sn: score_list){
-        if(bounded_score_map.count(sn))
-          sub.scores[sn] = bounded_score_map.at(sn)(sub,superunits.at(0));
-      }
-    }
+    prepared.emplace_back(superunits.at(0));
+    for(auto &p: sub_parent)
+      p = &prepared.at(0);
 
   } else {
 
@@ -198,34 +216,75 @@ void CalculateListOfBoundedScores(
       if(!mp.props.count(join_on))
         throw std::runtime_error("At least one subunit was missing the joining attribute!");
 
+    prepared.resize(superunits.size());
+    #pragma omp parallel for schedule(dynamic)
+    for(unsigned int i=0;i<superunits.size();i++)
+      prepared[i] = PreparedPolygon(superunits[i]);
+
     //A quick was to access superunits based on their key
-    std::unordered_map<std::string, const MultiPolygon *> su_key;
-    for(const auto &mp: superunits){
+    std::unordered_map<std::string, const PreparedPolygon *> su_key;
+    for(unsigned int i=0;i<superunits.size();i++){
+      const auto &mp = superunits[i];
       if(!mp.props.count(join_on))
         throw std::runtime_error("At least one superunit was missing the joining attribute!");
       if(su_key.count(mp.props.at(join_on)))
         throw std::runtime_error("More than one superunit had the same key!");
-      su_key[mp.props.at(join_on)] = &mp;
+      su_key[mp.props.at(join_on)] = &prepared[i];
     }
 
-    for(auto& sub: subunits){
-      for(const auto &sn: score_list){
-        if(bounded_score_map.count(sn))
-          sub.scores[sn] = bounded_score_map.at(sn)(sub,*su_key.at(sub.props.at(join_on)));
-      }
+    for(unsigned int i=0;i<subunits.size();i++)
+      sub_parent[i] = su_key.at(subunits[i].props.at(join_on));
+
+  }
+
+  std::vector<const bounded_score_map_t::mapped_type*> score_fns;
+  std::vector<std::string> score_names;
+  for(const auto &sn: score_list){
+    if(bounded_score_map.count(sn)){
+      score_fns.push_back(&bounded_score_map.at(sn));
+      score_names.push_back(sn);
     }
+  }
 
+  //Many subunits share a superunit, but geometry caches are safe to fill from
+  //multiple threads, so all (subunit, score) pairs can run in parallel. Results
+  //go into a flat buffer since the subunits' score maps are not thread-safe.
+  const int nsub    = subunits.size();
+  const int nscores = score_fns.size();
+  std::vector<double> results(nsub*nscores);
+
+  std::exception_ptr error;
+
+  #pragma omp parallel for collapse(2) schedule(dynamic)
+  for(int i=0;i<nsub;i++)
+  for(int s=0;s<nscores;s++){
+    //Exceptions can't leave a parallel region, so hold on to the first one
+    try {
+      results[i*nscores+s] = (*score_fns[s])(subunits[i], *sub_parent[i]);
+    } catch (...) {
+      #pragma omp critical
+      if(!error)
+        error = std::current_exception();
+    }
   }
+
+  if(error)
+    std::rethrow_exception(error);
+
+  for(int i=0;i<nsub;i++)
+  for(int s=0;s<nscores;s++)
+    subunits[i].scores[score_names[s]] = results[i*nscores+s];
 }
 
 
 
 const std::vector<std::string>& getListOfBoundedScores(){
-  static std::vector<std::string> score_names;
-  if(!score_names.empty())
-    return score_names;
-  for(const auto &kv: bounded_score_map)
-    score_names.push_back(kv.first);
+  static const std::vector<std::string> score_names = [](){
+    std::vector<std::string> temp;
+    for(const auto &kv: bounded_score_map)
+      temp.push_back(kv.first);
+    return temp;
+  }();
   return score_names;
 }
 
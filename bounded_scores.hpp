@@ -3,6 +3,7 @@
 
 #include "geojson.hpp"
 #include "geom.hpp"
+#include "prepared_polygon.hpp"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -11,7 +12,10 @@
 namespace complib {
   const std::vector<std::string>& getListOfBoundedScores();
 
-  double ScoreConvexHullPTB        (const MultiPolygon &mp, const MultiPolygon &border);
+  //Scores take the border prepared, since many subunits are usually scored
+  //against the same one. Callers build the PreparedPolygon once and reuse it.
+  double ScoreConvexHullPTB        (const MultiPolygon &mp, const PreparedPolygon &border);
+  double ScoreReockPTB             (const MultiPolygon &mp, const PreparedPolygon &border);
 
   void CalculateAllBoundedScores(
     GeoCollection &subunits,
@@ -26,7 +30,7 @@ namespace complib {
     std::vector<std::string> score_list
   );
 
-  typedef std::unordered_map<std::string, std::function<double(const MultiPolygon &subunit, const MultiPolygon &superunit)> > bounded_score_map_t;
+  typedef std::unordered_map<std::string, std::function<double(const MultiPolygon &subunit, const PreparedPolygon &superunit)> > bounded_score_map_t;
   extern const bounded_score_map_t bounded_score_map;
 }
 
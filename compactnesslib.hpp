@@ -5,9 +5,16 @@
 #include "bounded_scores.hpp"
 #include "geojson.hpp"
 #include "geom.hpp"
+#include "flat_geom.hpp"
+#include "ring_kernels.hpp"
 #include "shapefile.hpp"
 #include "csv.hpp"
 #include "wkt.hpp"
 #include "neighbours.hpp"
+#include "SpIndex.hpp"
+#include "GridIndex.hpp"
+#include "prepared_polygon.hpp"
+#include "geocode.hpp"
+#include "overlay.hpp"
 
 #endif
@@ -0,0 +1,327 @@
+#include "flat_geom.hpp"
+#include "ring_kernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+namespace complib {
+
+RingView::RingView(const Point2D *const pts0, const size_t n0) : pts(pts0), n(n0) {}
+
+size_t RingView::size() const {
+  return n;
+}
+
+const Point2D* RingView::data() const {
+  return pts;
+}
+
+const Point2D* RingView::begin() const {
+  return pts;
+}
+
+const Point2D* RingView::end() const {
+  return pts+n;
+}
+
+const Point2D& RingView::operator[](const size_t i) const {
+  return pts[i];
+}
+
+GeometrySummary RingView::summary() const {
+  const auto rp = RingPass(pts, n);
+
+  GeometrySummary temp;
+  temp.signed_area  = (n<3) ? 0 : -rp.shoelace/2.;
+  temp.area         = std::abs(temp.signed_area);
+  temp.perim        = rp.length;
+  temp.vertex_count = n;
+  temp.bbox         = rp.bbox;
+  return temp;
+}
+
+double RingView::area() const {
+  return summary().area;
+}
+
+double RingView::perim() const {
+  return summary().perim;
+}
+
+BoundingBox RingView::bbox() const {
+  BoundingBox bb;
+  ExpandBBox(pts, n, bb);
+  return bb;
+}
+
+Ring RingView::getHull() const {
+  return Ring(ConvexHull(pts, n));
+}
+
+Ring RingView::toRing() const {
+  Ring temp;
+  temp.v.assign(pts, pts+n);
+  return temp;
+}
+
+
+
+PolygonView::PolygonView(const FlatGeoCollection &fc0, const size_t id0) : fc(&fc0), id(id0) {}
+
+size_t PolygonView::size() const {
+  return fc->polygon_offsets[id+1]-fc->polygon_offsets[id];
+}
+
+RingView PolygonView::ring(const size_t r) const {
+  const size_t ri = fc->polygon_offsets[id]+r;
+  const size_t a  = fc->ring_offsets[ri];
+  return RingView(fc->points.data()+a, fc->ring_offsets[ri+1]-a);
+}
+
+RingView PolygonView::outer() const {
+  return ring(0);
+}
+
+GeometrySummary PolygonView::summary() const {
+  GeometrySummary temp;
+  for(size_t r=0;r<size();r++){
+    const auto rs = ring(r).summary();
+    if(r==0){
+      temp = rs;
+    } else {
+      temp.hole_area    += rs.area;
+      temp.hole_perim   += rs.perim;
+      temp.vertex_count += rs.vertex_count;
+    }
+  }
+  return temp;
+}
+
+double PolygonView::area() const {
+  return summary().area;
+}
+
+double PolygonView::perim() const {
+  return summary().perim;
+}
+
+BoundingBox PolygonView::bbox() const {
+  return outer().bbox();
+}
+
+Polygon PolygonView::toPolygon() const {
+  Polygon temp;
+  temp.v.reserve(size());
+  for(size_t r=0;r<size();r++)
+    temp.v.push_back(ring(r).toRing());
+  return temp;
+}
+
+
+
+FeatureView::FeatureView(const FlatGeoCollection &fc0, const size_t id0) : fc(&fc0), id(id0) {}
+
+size_t FeatureView::size() const {
+  return fc->feature_offsets[id+1]-fc->feature_offsets[id];
+}
+
+PolygonView FeatureView::polygon(const size_t p) const {
+  return PolygonView(*fc, fc->feature_offsets[id]+p);
+}
+
+const Props& FeatureView::props() const {
+  return fc->props.at(id);
+}
+
+GeometrySummary FeatureView::summary() const {
+  GeometrySummary temp;
+  for(size_t p=0;p<size();p++)
+    temp += polygon(p).summary();
+  return temp;
+}
+
+double FeatureView::area() const {
+  return summary().area;
+}
+
+double FeatureView::perim() const {
+  return summary().perim;
+}
+
+BoundingBox FeatureView::bbox() const {
+  BoundingBox bb;
+  for(size_t p=0;p<size();p++){
+    const auto outer = polygon(p).outer();
+    ExpandBBox(outer.data(), outer.size(), bb);
+  }
+  return bb;
+}
+
+//As MultiPolygon::getHull(): holes can't touch the hull, so only the vertices
+//of the outer rings' hulls need to be merged
+Ring FeatureView::getHull() const {
+  if(size()==1)
+    return polygon(0).outer().getHull();
+
+  Points temp;
+  for(size_t p=0;p<size();p++){
+    const auto outer = polygon(p).outer();
+    const auto ohull = ConvexHull(outer.data(), outer.size());
+    temp.insert(temp.end(),ohull.begin(),ohull.end());
+  }
+  return Ring(ConvexHull(temp.data(), temp.size()));
+}
+
+MultiPolygon FeatureView::toMultiPolygon() const {
+  MultiPolygon temp;
+  temp.v.reserve(size());
+  for(size_t p=0;p<size();p++)
+    temp.v.push_back(polygon(p).toPolygon());
+  temp.props = props();
+  return temp;
+}
+
+
+
+FlatGeoCollection::FlatGeoCollection(const GeoCollection &gc){
+  size_t npoints = 0, nrings = 0, npolygons = 0;
+  for(const auto &mp: gc)
+  for(const auto &poly: mp){
+    npolygons++;
+    nrings += poly.size();
+    for(const auto &ring: poly)
+      npoints += ring.size();
+  }
+  reserve(npoints, nrings, npolygons, gc.size());
+
+  for(const auto &mp: gc){
+    for(const auto &poly: mp){
+      for(const auto &ring: poly){
+        points.insert(points.end(), ring.begin(), ring.end());
+        endRing();
+      }
+      endPolygon();
+    }
+    endFeature(mp.props);
+  }
+  prj_str = gc.prj_str;
+}
+
+size_t FlatGeoCollection::size() const {
+  return feature_offsets.size()-1;
+}
+
+bool FlatGeoCollection::empty() const {
+  return size()==0;
+}
+
+FeatureView FlatGeoCollection::operator[](const size_t f) const {
+  return FeatureView(*this, f);
+}
+
+FeatureView FlatGeoCollection::at(const size_t f) const {
+  if(f>=size())
+    throw std::out_of_range("Feature index out of range!");
+  return FeatureView(*this, f);
+}
+
+size_t FlatGeoCollection::ringCount() const {
+  return ring_offsets.size()-1;
+}
+
+size_t FlatGeoCollection::polygonCount() const {
+  return polygon_offsets.size()-1;
+}
+
+void FlatGeoCollection::addPoint(const double x, const double y){
+  points.emplace_back(x,y);
+}
+
+void FlatGeoCollection::endRing(){
+  if(points.size()==ring_offsets.back())
+    throw std::runtime_error("Cannot end an empty ring!");
+  ring_offsets.push_back(points.size());
+}
+
+void FlatGeoCollection::endPolygon(){
+  if(!polygonOpen())
+    throw std::runtime_error("Cannot end a polygon without rings!");
+  polygon_offsets.push_back(ringCount());
+}
+
+void FlatGeoCollection::endFeature(const Props &fprops){
+  feature_offsets.push_back(polygonCount());
+  props.push_back(fprops);
+}
+
+bool FlatGeoCollection::polygonOpen() const {
+  return ringCount()>polygon_offsets.back();
+}
+
+void FlatGeoCollection::reserve(const size_t npoints, const size_t nrings, const size_t npolygons, const size_t nfeatures){
+  points.reserve(npoints);
+  ring_offsets.reserve(nrings+1);
+  polygon_offsets.reserve(npolygons+1);
+  feature_offsets.reserve(nfeatures+1);
+  props.reserve(nfeatures);
+}
+
+void FlatGeoCollection::reverse(){
+  for(size_t r=0;r<ringCount();r++)
+    std::reverse(points.begin()+ring_offsets[r], points.begin()+ring_offsets[r+1]);
+}
+
+void FlatGeoCollection::correctWindingDirection(){
+  const auto s = at(0).summary();
+  if(s.area-s.hole_area<0){
+    std::cerr<<"Reversed winding of polygons!"<<std::endl;
+    reverse();
+  }
+}
+
+GeoCollection FlatGeoCollection::toGeoCollection() const {
+  GeoCollection gc;
+  gc.reserve(size());
+  for(size_t f=0;f<size();f++)
+    gc.push_back((*this)[f].toMultiPolygon());
+  gc.prj_str = prj_str;
+  return gc;
+}
+
+
+
+void GeoCollectionBuilder::addPoint(const double x, const double y){
+  points.emplace_back(x,y);
+}
+
+void GeoCollectionBuilder::endRing(){
+  if(points.empty())
+    throw std::runtime_error("Cannot end an empty ring!");
+  rings.emplace_back();
+  rings.back().v.assign(points.begin(), points.end());
+  points.clear();
+}
+
+void GeoCollectionBuilder::endPolygon(){
+  if(!polygonOpen())
+    throw std::runtime_error("Cannot end a polygon without rings!");
+  polygons.emplace_back();
+  polygons.back().v.swap(rings);
+}
+
+void GeoCollectionBuilder::endFeature(const Props &fprops){
+  gc.v.emplace_back();
+  gc.v.back().v.swap(polygons);
+  gc.v.back().props = fprops;
+}
+
+bool GeoCollectionBuilder::polygonOpen() const {
+  return !rings.empty();
+}
+
+void GeoCollectionBuilder::reserve(const size_t, const size_t, const size_t, const size_t nfeatures){
+  gc.v.reserve(nfeatures);
+}
+
+}
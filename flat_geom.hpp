@@ -0,0 +1,181 @@
+#ifndef _flat_geom_hpp_
+#define _flat_geom_hpp_
+
+#include "geom.hpp"
+#include "Props.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace complib {
+
+class FlatGeoCollection;
+
+///A ring stored in a FlatGeoCollection: n contiguous points, closed as read.
+///Views are cheap to copy and stay valid until the collection is modified.
+class RingView {
+ public:
+  RingView(const Point2D *const pts0, const size_t n0);
+
+  size_t         size () const;
+  const Point2D* data () const;
+  const Point2D* begin() const;
+  const Point2D* end  () const;
+  const Point2D& operator[](const size_t i) const;
+
+  ///As Ring::summary(), but computed afresh on each call
+  GeometrySummary summary() const;
+  double          area   () const;
+  double          perim  () const;
+  BoundingBox     bbox   () const;
+  Ring            getHull() const;
+
+  ///Copy into a Ring
+  Ring toRing() const;
+
+ private:
+  const Point2D *pts;
+  size_t         n;
+};
+
+///A polygon stored in a FlatGeoCollection: its first ring is the outer ring and
+///the rest are holes
+class PolygonView {
+ public:
+  PolygonView(const FlatGeoCollection &fc0, const size_t id0);
+
+  ///Number of rings
+  size_t   size () const;
+  RingView ring (const size_t r) const;
+  RingView outer() const;
+
+  ///As Polygon::summary(): area and perimeter are of the outer ring
+  GeometrySummary summary() const;
+  double          area   () const;
+  double          perim  () const;
+  BoundingBox     bbox   () const;
+
+  ///Copy into a Polygon
+  Polygon toPolygon() const;
+
+ private:
+  const FlatGeoCollection *fc;
+  size_t                   id;
+};
+
+///A feature (multipolygon) stored in a FlatGeoCollection
+class FeatureView {
+ public:
+  FeatureView(const FlatGeoCollection &fc0, const size_t id0);
+
+  ///Number of polygons
+  size_t       size   () const;
+  PolygonView  polygon(const size_t p) const;
+  const Props& props  () const;
+
+  ///As MultiPolygon::summary()
+  GeometrySummary summary() const;
+  double          area   () const;
+  double          perim  () const;
+  BoundingBox     bbox   () const;
+  ///Convex hull of the feature, from the hulls of its outer rings
+  Ring            getHull() const;
+
+  ///Copy into a MultiPolygon, properties included
+  MultiPolygon toMultiPolygon() const;
+
+ private:
+  const FlatGeoCollection *fc;
+  size_t                   id;
+};
+
+///A collection of features whose coordinates all live in one contiguous array.
+///Rings, polygons, and features are ranges of the level below, given by offset
+///arrays: ring r is points[ring_offsets[r]] up to points[ring_offsets[r+1]],
+///polygon p is rings polygon_offsets[p] up to polygon_offsets[p+1], and feature
+///f is polygons feature_offsets[f] up to feature_offsets[f+1]. Loading a file
+///into it takes a handful of allocations rather than one per ring, and the
+///score kernels then stream through memory in order.
+///
+///Points are stored interleaved, rather than as separate x and y arrays, so
+///that the ring kernels (ring_kernels.hpp) and hulls run on them unchanged.
+///
+///The collection is filled by appending points and closing off rings,
+///polygons, and features in turn:
+///
+///    fc.addPoint(...); ...; fc.endRing(); ...; fc.endPolygon(); ...; fc.endFeature();
+class FlatGeoCollection {
+ public:
+  Points              points;
+  std::vector<size_t> ring_offsets    = {0};
+  std::vector<size_t> polygon_offsets = {0};
+  std::vector<size_t> feature_offsets = {0};
+  std::vector<Props>  props;           ///< One entry per feature
+  std::string         prj_str;
+
+  FlatGeoCollection() = default;
+  explicit FlatGeoCollection(const GeoCollection &gc);
+
+  ///Number of features
+  size_t      size() const;
+  bool        empty() const;
+  FeatureView operator[](const size_t f) const;
+  FeatureView at(const size_t f) const;
+
+  size_t ringCount   () const;
+  size_t polygonCount() const;
+
+  void addPoint   (const double x, const double y);
+  ///Close the ring made of the points added since the last ring. Throws if it
+  ///is empty.
+  void endRing    ();
+  ///Close the polygon made of the rings ended since the last polygon. Throws if
+  ///it has no rings.
+  void endPolygon ();
+  ///Close the feature made of the polygons ended since the last feature. A
+  ///feature may have no polygons.
+  void endFeature (const Props &fprops = Props());
+
+  ///Whether rings have been ended since the last polygon was
+  bool polygonOpen() const;
+
+  void reserve(const size_t npoints, const size_t nrings, const size_t npolygons, const size_t nfeatures);
+
+  ///Reverse every ring
+  void reverse();
+  ///Make outer rings run counter-clockwise, judging by the first feature, as
+  ///GeoCollection::correctWindingDirection() does
+  void correctWindingDirection();
+
+  ///Copy into the nested representation. Each ring is allocated at its exact
+  ///size.
+  GeoCollection toGeoCollection() const;
+};
+
+///Fills a nested GeoCollection through the same calls as a FlatGeoCollection
+///(addPoint(), endRing(), endPolygon(), endFeature()), so that a reader written
+///against that interface can load either representation directly. Points are
+///gathered in a reused buffer and each ring is allocated once, at its exact
+///size.
+class GeoCollectionBuilder {
+ public:
+  GeoCollection gc;
+
+  void addPoint   (const double x, const double y);
+  void endRing    ();
+  void endPolygon ();
+  void endFeature (const Props &fprops = Props());
+  bool polygonOpen() const;
+
+  ///Only the number of features is used
+  void reserve(const size_t npoints, const size_t nrings, const size_t npolygons, const size_t nfeatures);
+
+ private:
+  Points   points;
+  Rings    rings;
+  Polygons polygons;
+};
+
+}
+
+#endif
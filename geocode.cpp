@@ -0,0 +1,39 @@
+#include "geocode.hpp"
+#include "prepared_polygon.hpp"
+#include "SpIndex.hpp"
+
+namespace complib {
+
+std::vector<unsigned int> AssignPointsToPolygons(const Points &points, const GeoCollection &gc){
+  std::vector<unsigned int> owners(points.size(), NO_FEATURE);
+  if(gc.size()==0 || points.empty())
+    return owners;
+
+  SpIndex sp;
+  for(unsigned int i=0;i<gc.size();i++)
+    AddToSpIndex(gc[i], sp, i, 0);
+  sp.buildIndex();
+
+  std::vector<PointInPolygonIndex> pips(gc.size());
+  #pragma omp parallel for schedule(dynamic)
+  for(unsigned int i=0;i<gc.size();i++)
+    pips[i] = PointInPolygonIndex(gc[i]);
+
+  //Points are handed out in batches so that neighbouring points, which tend to
+  //visit the same features, stay on the same thread
+  const long npts = points.size();
+  #pragma omp parallel for schedule(dynamic,4096)
+  for(long i=0;i<npts;i++){
+    const auto &p = points[i];
+    unsigned int owner = NO_FEATURE;
+    sp.query(BoundingBox(p.x,p.y,p.x,p.y), [&](const unsigned int f){
+      if(f<owner && pips[f].contains(p))
+        owner = f;
+    });
+    owners[i] = owner;
+  }
+
+  return owners;
+}
+
+}
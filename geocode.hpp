@@ -0,0 +1,23 @@
+#ifndef _geocode_hpp_
+#define _geocode_hpp_
+
+#include "geom.hpp"
+#include <limits>
+#include <vector>
+
+namespace complib {
+
+///Owner given to points which lie in none of the features
+const unsigned int NO_FEATURE = std::numeric_limits<unsigned int>::max();
+
+///Find the feature of `gc` containing each point, such as the district holding
+///each census-block centroid or voter address. Returns one entry per point:
+///the index of the containing feature in `gc`, or NO_FEATURE. Where features
+///overlap, the one with the lowest index wins. Candidates come from a spatial
+///index of the features' bounding boxes and are confirmed with a slab-bucketed
+///point-in-polygon test; the points are processed in parallel.
+std::vector<unsigned int> AssignPointsToPolygons(const Points &points, const GeoCollection &gc);
+
+}
+
+#endif
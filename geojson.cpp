@@ -7,6 +7,7 @@
 #include <stdexcept>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <map>
 
 using json = nlohmann::json;
@@ -19,11 +20,11 @@ std::map<std::string, GeoCollection> prepped_geojson;
 //template<typename T> struct TD;
 //e.g. TD<decltype(WHAT_AM_I_VAR_NAME)> td;
 
-Ring ParseRing(const json &r){
-  Ring temp;
+template<class Builder>
+static void ParseRing(const json &r, Builder &fc){
   for(const auto &c: r)
-    temp.emplace_back(c[0],c[1]);
-  return temp;
+    fc.addPoint(c[0],c[1]);
+  fc.endRing();
 }
 
 
@@ -32,16 +33,15 @@ Ring ParseRing(const json &r){
 //d["properties"].Accept(writer);
 //std::string s = sb.GetString();
 
-Polygon ParsePolygon(const json &coor){
-  Polygon mp;
+template<class Builder>
+static void ParsePolygon(const json &coor, Builder &fc){
   //First ring is the outer ring, all the others are holes
   for(const auto &r: coor)
-    mp.push_back(ParseRing(r));
-
-  return mp;
+    ParseRing(r, fc);
+  fc.endPolygon();
 }
 
-const json& GetToCoordinates(const json &d){
+static const json& GetToCoordinates(const json &d){
   if(d.count("geometry")){
     return d.at("geometry").at("coordinates");
   } else if(d.count("coordinates")){
@@ -51,48 +51,42 @@ const json& GetToCoordinates(const json &d){
   }
 }
 
-MultiPolygon ParseTopPolygon(const json &d){
-  MultiPolygon mps;
-  mps.push_back(ParsePolygon(GetToCoordinates(d)));
-  return mps;
+template<class Builder>
+static void ParseTopPolygon(const json &d, Builder &fc){
+  ParsePolygon(GetToCoordinates(d), fc);
 }
 
-MultiPolygon ParseMultiPolygon(const json &d){
-  MultiPolygon mps;
+template<class Builder>
+static void ParseMultiPolygon(const json &d, Builder &fc){
   for(const auto &poly: GetToCoordinates(d))
-    mps.emplace_back(ParsePolygon(poly));
-
-  return mps;
+    ParsePolygon(poly, fc);
 }
 
-MultiPolygon ParseFeature(const json &d){
-  MultiPolygon mp;
-
+template<class Builder>
+static void ParseFeature(const json &d, Builder &fc){
   const std::string geotype = d["geometry"]["type"];
   if(geotype=="MultiPolygon")
-    mp = ParseMultiPolygon(d);
+    ParseMultiPolygon(d, fc);
   else if(geotype=="Polygon")
-    mp = ParseTopPolygon(d);
+    ParseTopPolygon(d, fc);
   else
     throw std::runtime_error("Unexpected data type - skipping!");
 
-
+  Props props;
   if(d.count("properties")){
     const json &this_props = d["properties"];
     for(json::const_iterator it = this_props.begin(); it != this_props.end(); ++it){
       const json &thisval = this_props[it.key()];
-      mp.props[it.key()] = thisval.dump();
+      props[it.key()] = thisval.dump();
     }
   }
 
-  return mp;
+  fc.endFeature(props);
 }
 
-GeoCollection ReadGeoJSON(const std::string geojson){
-  if(geojson.compare(0,2,"__")==0)
-    return prepped_geojson.at(geojson);
-
-  GeoCollection mps;
+//Fills `fc` with the features of a GeoJSON string. Winding is not corrected.
+template<class Builder>
+static void ParseGeoJSON(const std::string &geojson, Builder &fc){
   auto d = json::parse(geojson);
 
   if(!d.is_object())
@@ -104,19 +98,48 @@ GeoCollection ReadGeoJSON(const std::string geojson){
     throw std::runtime_error("Type not a string!");
 
   if(d["type"]=="MultiPolygon"){
-    mps.push_back(ParseMultiPolygon(d));
+    ParseMultiPolygon(d, fc);
+    fc.endFeature();
   } else if(d["type"]=="Polygon"){
-    mps.push_back(ParseTopPolygon(d));
+    ParseTopPolygon(d, fc);
+    fc.endFeature();
   } else if(d["type"]=="FeatureCollection"){
+    fc.reserve(0, 0, 0, d["features"].size());
     for(const auto &f: d["features"])
-      mps.push_back(ParseFeature(f));
+      ParseFeature(f, fc);
   } else {
     throw std::runtime_error("Not a FeatureCollection or MultiPolygon or Polygon!");
   }
+}
+
+FlatGeoCollection ReadGeoJSONFlat(const std::string geojson){
+  if(geojson.compare(0,2,"__")==0)
+    return FlatGeoCollection(prepped_geojson.at(geojson));
+
+  FlatGeoCollection fc;
+  ParseGeoJSON(geojson, fc);
+  fc.correctWindingDirection();
 
-  mps.correctWindingDirection();
+  return fc;
+}
+
+GeoCollection ReadGeoJSON(const std::string geojson){
+  if(geojson.compare(0,2,"__")==0)
+    return prepped_geojson.at(geojson);
+
+  GeoCollectionBuilder builder;
+  ParseGeoJSON(geojson, builder);
+  builder.gc.correctWindingDirection();
+
+  return std::move(builder.gc);
+}
+
+FlatGeoCollection ReadGeoJSONFileFlat(std::string filename){
+  std::ifstream fin(filename);
+
+  std::string geojson((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
 
-  return mps;
+  return ReadGeoJSONFlat(geojson);
 }
 
 GeoCollection ReadGeoJSONFile(std::string filename){
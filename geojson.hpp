@@ -2,6 +2,7 @@
 #define _geojson_hpp_
 
 #include "geom.hpp"
+#include "flat_geom.hpp"
 
 namespace complib {
 
@@ -10,6 +11,9 @@ namespace complib {
   GeoCollection ReadGeoJSON(std::string geojson);
   GeoCollection ReadGeoJSONFile(std::string filename);
 
+  FlatGeoCollection ReadGeoJSONFlat(std::string geojson);
+  FlatGeoCollection ReadGeoJSONFileFlat(std::string filename);
+
   std::string OutScoreJSON(const GeoCollection &gc, const std::string id);
 }
 
@@ -1,4 +1,5 @@
 #include "geom.hpp"
+#include "ring_kernels.hpp"
 #include <cmath>
 #include <algorithm>
 #include <limits>
@@ -10,7 +11,7 @@
 #include <memory>
 #include "lib/clipper.hpp"
 #include "lib/doctest.h"
-#include "lib/miniball.hpp"
+#include <random>
 
 static const double DEG_TO_RAD = M_PI/180.0;
 static const double RAD_TO_DEG = 180.0/M_PI;
@@ -97,21 +98,81 @@ Ring::Ring(const std::vector<Point2D> &ptvec) {
 }
 
 
+
+GeometrySummary& GeometrySummary::operator+=(const GeometrySummary &o){
+  area         += o.area;
+  signed_area  += o.signed_area;
+  perim        += o.perim;
+  hole_area    += o.hole_area;
+  hole_perim   += o.hole_perim;
+  vertex_count += o.vertex_count;
+  bbox.xmin()   = std::min(bbox.xmin(),o.bbox.xmin());
+  bbox.ymin()   = std::min(bbox.ymin(),o.bbox.ymin());
+  bbox.xmax()   = std::max(bbox.xmax(),o.bbox.xmax());
+  bbox.ymax()   = std::max(bbox.ymax(),o.bbox.ymax());
+  return *this;
+}
+
+const GeometrySummary& Ring::summary() const {
+  return summary_cache.get([&](){
+    //Area, perimeter, and bounding box all come from one pass over the points
+    const auto rp = RingPass(v.data(), v.size());
+
+    GeometrySummary temp;
+    temp.signed_area  = (v.size()<3) ? 0 : -rp.shoelace/2.;
+    temp.area         = std::abs(temp.signed_area);
+    temp.perim        = rp.length;
+    temp.vertex_count = v.size();
+    temp.bbox         = rp.bbox;
+    return temp;
+  });
+}
+
+void Ring::clearCache(){
+  hull_cache.clear();
+  summary_cache.clear();
+}
+
+const GeometrySummary& Polygon::summary() const {
+  return summary_cache.get([&](){
+    GeometrySummary temp;
+    for(unsigned int i=0;i<v.size();i++){
+      const auto &rs = v[i].summary();
+      if(i==0){
+        temp = rs;
+      } else {
+        temp.hole_area    += rs.area;
+        temp.hole_perim   += rs.perim;
+        temp.vertex_count += rs.vertex_count;
+      }
+    }
+    return temp;
+  });
+}
+
+void Polygon::clearCache(){
+  for(auto &r: v)
+    r.clearCache();
+  clearOwnCache();
+}
+
+void Polygon::clearOwnCache(){
+  summary_cache.clear();
+}
+
+
 //Andrew's monotone chain convex hull algorithm
 //https://en.wikibooks.org/wiki/Algorithm_Implementation/Geometry/Convex_hull/Monotone_chain
-Ring Ring::getHull() const {
-  if(!hull.empty())
-    return hull;
-
-  if (v.size() < 3)
+static Points MonotoneChainHull(const Point2D *const v, const size_t n){
+  if (n < 3)
     throw std::runtime_error("There must be at least 3 points for a convex hull!");
 
   const auto cross = [&](const Point2D &a, const Point2D &b, const Point2D &o) {
     return (a.x-o.x)*(b.y-o.y) - (a.y-o.y)*(b.x-o.x);
   };
 
-  std::vector<unsigned int> idx(v.size(),0);
-  for(unsigned int i=0;i<v.size();i++)
+  std::vector<unsigned int> idx(n,0);
+  for(unsigned int i=0;i<n;i++)
     idx[i] = i;
 
   std::sort(idx.begin(),idx.end(),[&](const unsigned int a, const unsigned int b){
@@ -122,7 +183,7 @@ Ring Ring::getHull() const {
 
   //Lower half of hull
   std::vector<Point2D> L;
-  for(unsigned int i=0;i<v.size();i++){
+  for(unsigned int i=0;i<n;i++){
     const auto &thisp = v[idx[i]];
     while(L.size()>=2 && cross(L[L.size()-2], L[L.size()-1], thisp)<=0)
       L.pop_back();
@@ -130,7 +191,7 @@ Ring Ring::getHull() const {
   }
 
   std::vector<Point2D> U;
-  for(int i=((signed int)v.size())-1;i>=0;i--){
+  for(int i=((signed int)n)-1;i>=0;i--){
     const auto &thisp = v[idx[i]];
     while(U.size()>=2 && cross(U[U.size()-2], U[U.size()-1], thisp)<=0)
       U.pop_back();
@@ -145,13 +206,185 @@ Ring Ring::getHull() const {
   //Close the ring
   L.push_back(L.front());
 
-  hull = L;
-
   //NOTE: It may be necessary to reverse the ring to give a positive area
 
+  return L;
+}
+
+//Is p inside or on the convex, counter-clockwise, open polygon H[0..m)? Uses a
+//binary search over the fan of triangles from H[0], so takes O(log m).
+static bool InsideConvexPolygon(const Point2D *const H, const unsigned int m, const Point2D &p){
+  const auto cross = [](const Point2D &a, const Point2D &b, const Point2D &c){
+    return (b.x-a.x)*(c.y-a.y) - (b.y-a.y)*(c.x-a.x);
+  };
+  //Points exactly on an edge should pass despite rounding
+  const auto left_or_on = [&](const Point2D &a, const Point2D &b, const Point2D &c){
+    const double tol = 1e-12*(EuclideanDistanceSquared(a,b)+EuclideanDistanceSquared(a,c));
+    return cross(a,b,c) >= -tol;
+  };
+
+  if(!left_or_on(H[0],H[1],p) || !left_or_on(H[m-1],H[0],p))
+    return false;
+
+  //Find the wedge H[lo], H[lo+1] of the fan which contains p
+  unsigned int lo = 1;
+  unsigned int hi = m-1;
+  while(hi-lo>1){
+    const unsigned int mid = (lo+hi)/2;
+    if(cross(H[0],H[mid],p)>=0)
+      lo = mid;
+    else
+      hi = mid;
+  }
+
+  return left_or_on(H[lo],H[lo+1],p);
+}
+
+
+
+//Melkman's algorithm, verified: an O(n log h) convex hull for rings.
+//
+//Melkman's algorithm is an O(n) convex hull for simple polylines, which a valid
+//ring is. The ring's points are taken in order and the hull so far is kept on a
+//deque, with new points going onto both ends. The deque is laid out directly in
+//`hull`, which is then shifted down over itself, so the only allocation is the
+//output. http://geomalgorithms.com/a12-_hull-3.html
+//
+//Melkman's algorithm silently gives wrong answers for self-intersecting rings,
+//and telling whether a ring is simple costs more than the hull itself, so the
+//result is verified instead: it must be a strictly convex polygon which winds
+//once and contains every point of the ring. Only if it passes is it, by
+//definition, the convex hull. The convexity and winding checks are O(h) and
+//exact; the containment check is a binary search per point, O(n log h), which
+//dominates for valid rings but is still much cheaper than the sort in the
+//monotone chain. Returns false if the ring cannot be handled this way (too few
+//points, all collinear, or failing verification), in which case the caller
+//should fall back to a general hull algorithm; only such rings pay for both.
+static bool VerifiedMelkmanHull(const Point2D *const v, const size_t nv, Points &hull){
+  const auto is_left = [](const Point2D &a, const Point2D &b, const Point2D &c){
+    return (b.x-a.x)*(c.y-a.y) - (c.x-a.x)*(b.y-a.y);
+  };
+  const auto same = [](const Point2D &a, const Point2D &b){
+    return a.x==b.x && a.y==b.y;
+  };
+
+  //Ignore the ring's closing point
+  long n = nv;
+  if(n>1 && same(v[0],v[n-1]))
+    n--;
+  if(n<3)
+    return false;
+
+  //Start at the lexicographically smallest point. It's on the hull and, if the
+  //start of the ring is a straight run, it's an endpoint of that run.
+  long start = 0;
+  for(long i=1;i<n;i++)
+    if(v[i].x<v[start].x || (v[i].x==v[start].x && v[i].y<v[start].y))
+      start = i;
+  const auto P = [&](const long i) -> const Point2D& { return v[(start+i)%n]; };
+
+  //The initial triangle is the starting point, the far end of any straight run
+  //which follows it, and the first point off that line
+  const Point2D a = P(0);
+  long k = 1;
+  while(k<n && same(P(k),a))
+    k++;
+  if(k>=n)
+    return false;
+  Point2D b = P(k++);
+  for(;k<n;k++){
+    if(is_left(a,b,P(k))!=0)
+      break;
+    if(EuclideanDistanceSquared(a,P(k))>EuclideanDistanceSquared(a,b))
+      b = P(k);
+  }
+  if(k>=n)
+    return false; //All the points are collinear
+  const Point2D c = P(k++);
+
+  //The deque. Each remaining point is pushed at most once onto each end.
+  auto &D = hull;
+  D.resize(2*n+1);
+  long bot = n-2;
+  long top = bot+3;
+  D[bot] = D[top] = c;
+  if(is_left(a,b,c)>0){
+    D[bot+1] = a;
+    D[bot+2] = b;
+  } else {
+    D[bot+1] = b;
+    D[bot+2] = a;
+  }
+
+  for(;k<n;k++){
+    const auto &p = P(k);
+
+    //Points inside the current hull can't change it
+    if(is_left(D[bot],D[bot+1],p)>0 && is_left(D[top-1],D[top],p)>0)
+      continue;
+
+    while(top-bot>2 && is_left(D[bot],D[bot+1],p)<=0)
+      bot++;
+    D[--bot] = p;
+
+    while(top-bot>2 && is_left(D[top-1],D[top],p)<=0)
+      top--;
+    D[++top] = p;
+  }
+
+  //Deque holds a closed, counter-clockwise ring. Move it to the front.
+  std::copy(D.begin()+bot, D.begin()+top+1, D.begin());
+  D.resize(top-bot+1);
+
+  //Verify the result (see above) on the open ring H[0..m)
+  const Point2D *const H = hull.data();
+  const long m = hull.size()-1;
+  if(m<3)
+    return false;
+
+  //Every turn must be strictly to the left. Edge directions then advance
+  //monotonically, less than half a turn at a time, so the ring winds once if
+  //and only if their angle wraps past the +x axis exactly once. Angles are
+  //compared exactly, by half-plane and then cross product.
+  const auto upper_half = [](const double dx, const double dy){
+    return dy>0 || (dy==0 && dx>0);
+  };
+  long wraps = 0;
+  for(long i=0;i<m;i++){
+    const auto &p0 = H[i];
+    const auto &p1 = H[(i+1)%m];
+    const auto &p2 = H[(i+2)%m];
+    if(is_left(p0,p1,p2)<=0)
+      return false;
+    //Does the direction of p1->p2 have a smaller angle than that of p0->p1?
+    const bool h01 = upper_half(p1.x-p0.x, p1.y-p0.y);
+    const bool h12 = upper_half(p2.x-p1.x, p2.y-p1.y);
+    if(h01!=h12 ? h12 : false)
+      wraps++;
+  }
+  if(wraps!=1)
+    return false;
+
+  for(long i=0;i<n;i++)
+    if(!InsideConvexPolygon(H, m, v[i]))
+      return false;
+
+  return true;
+}
+
+Points ConvexHull(const Point2D *const pts, const size_t n){
+  Points hull;
+  if(!VerifiedMelkmanHull(pts,n,hull))
+    hull = MonotoneChainHull(pts,n);
   return hull;
 }
 
+const Ring& Ring::getHull() const {
+  return hull_cache.get([&](){
+    return Ring(ConvexHull(v.data(), v.size()));
+  });
+}
+
 
 
 
@@ -164,6 +397,7 @@ void MultiPolygon::toRadians(){
     pt.x *= DEG_TO_RAD;
     pt.y *= DEG_TO_RAD;
   }
+  clearCache();
 }
 
 void MultiPolygon::toDegrees(){
@@ -173,23 +407,25 @@ void MultiPolygon::toDegrees(){
     pt.x *= RAD_TO_DEG;
     pt.y *= RAD_TO_DEG;
   }
+  clearCache();
 }
 
+//The hull of a multipolygon is the hull of its polygons' outer-ring hulls:
+//holes lie inside their outer rings and can never touch the hull. The outer
+//hulls are cached (and shared with, e.g., hullAreaPolygonOuterRings), so only
+//their vertices need to be merged, rather than every coordinate.
 const Ring& MultiPolygon::getHull() const {
-  if(!hull.empty())
-    return hull;
-
-  //Put all of the points into a ring 
-  Ring temp;
-  for(const auto &poly: v)
-  for(const auto &ring: poly)
-    temp.v.insert(temp.end(),ring.begin(),ring.end());
-  temp.getHull();
-
-  //Move temporary's hull into mp's hull
-  std::swap(hull.v,temp.hull);
-
-  return hull;
+  return hull_cache.get([&](){
+    if(v.size()==1)
+      return v.front().at(0).getHull();
+
+    Points temp;
+    for(const auto &poly: v){
+      const auto &ohull = poly.at(0).getHull();
+      temp.insert(temp.end(),ohull.begin(),ohull.end());
+    }
+    return Ring(MonotoneChainHull(temp.data(), temp.size()));
+  });
 }
 
 void MultiPolygon::reverse() {
@@ -198,20 +434,31 @@ void MultiPolygon::reverse() {
     for(unsigned int i=1;i<poly.size();i++)
       std::reverse(poly.at(i).begin(),poly.at(i).end());
   }
+  clearCache();
 }
 
 BoundingBox MultiPolygon::bbox() const {
-  BoundingBox bb;
-  for(const auto &p: *this)
-  for(const auto &r: p)
-  for(const auto &pt: r){
-    bb.xmin() = std::min(bb.xmin(),pt.x);
-    bb.xmax() = std::max(bb.xmax(),pt.x);
-    bb.ymin() = std::min(bb.ymin(),pt.y);
-    bb.ymax() = std::max(bb.ymax(),pt.y);
-  }
+  return summary().bbox;
+}
 
-  return bb;
+const GeometrySummary& MultiPolygon::summary() const {
+  return summary_cache.get([&](){
+    GeometrySummary temp;
+    for(const auto &poly: v)
+      temp += poly.summary();
+    return temp;
+  });
+}
+
+void MultiPolygon::clearCache(){
+  for(auto &poly: v)
+    poly.clearCache();
+  clearOwnCache();
+}
+
+void MultiPolygon::clearOwnCache(){
+  hull_cache.clear();
+  summary_cache.clear();
 }
 
 void GeoCollection::reverse() {
@@ -234,23 +481,7 @@ void GeoCollection::clipperify() {
 
 
 double area(const Ring &r){
-  double area = 0;
-
-  if(r.size()<3)
-    return 0;
-
-  //The "shoelace" algorithm
-  unsigned int j = r.size()-1;
-  for(unsigned int i=0;i<r.size();i++){
-    //std::cerr<<"j="<<j<<", i="<<i<<", size="<<r.size();
-    //std::cerr<<", xj="<<r[j].x<<", yj="<<r[j].y<<std::endl;
-    area += (r[j].x + r[i].x) * (r[j].y - r[i].y);
-    j = i;
-  }
-  
-  area = area/2.;
-
-  return std::abs(area);
+  return r.summary().area;
 }
 
 //Produces the same answers as the foregoing, but with the opposite signedness of area
@@ -271,33 +502,23 @@ double area(const Ring &r){
 
 
 double perim(const Ring &r){
-  double perim = 0;
-
-  if(r.size()==1)
-    return 0;
-
-  for(unsigned int i=0;i<r.size()-1;i++)
-    perim += EuclideanDistance(r[i],r[i+1]);
-  perim += EuclideanDistance(r.front(),r.back());
-
-  return perim;
+  return r.summary().perim;
 }
 
 double hullArea(const Ring &r){
-  r.getHull();
-  return area(r.hull);
+  return area(r.getHull());
 }
 
 double areaIncludingHoles(const Polygon &p){
-  return area(p.at(0));
+  return p.summary().area;
 }
 
 double areaHoles(const Polygon &p){
-  return std::accumulate(p.begin()+1,p.end(),0.0,[](const double b, const Ring &r){ return b+area(r);});
+  return p.summary().hole_area;
 }
 
 double areaIncludingHoles(const MultiPolygon &mp){
-  return std::accumulate(mp.begin(),mp.end(),0.0,[](const double b, const Polygon &p){ return b+areaIncludingHoles(p);}); 
+  return mp.summary().area;
 }
 
 double areaExcludingHoles(const MultiPolygon &mp){
@@ -305,31 +526,31 @@ double areaExcludingHoles(const MultiPolygon &mp){
 }
 
 double areaHoles(const MultiPolygon &mp){
-  return std::accumulate(mp.begin(),mp.end(),0.0,[](const double b, const Polygon &p){ return b+areaHoles(p);}); 
+  return mp.summary().hole_area;
 }
 
 double perimExcludingHoles(const Polygon &p){
-  return perim(p.at(0));
+  return p.summary().perim;
 }
 
 double perimHoles(const Polygon &p){
-  return std::accumulate(p.begin()+1,p.end(),0.0,[](const double b, const Ring &r){ return b+perim(r);});
+  return p.summary().hole_perim;
 }
 
 double perimExcludingHoles(const MultiPolygon &mp){
-  return std::accumulate(mp.begin(),mp.end(),0.0,[](const double b, const Polygon &p){ return b+perimExcludingHoles(p);}); 
+  return mp.summary().perim;
 }
 
 double perimIncludingHoles(const Polygon &p){
-  return std::accumulate(p.begin(),p.end(),0.0,[](const double b, const Ring &r){ return b+perim(r);});
+  return p.summary().perim + p.summary().hole_perim;
 }
 
 double perimIncludingHoles(const MultiPolygon &mp){
-  return std::accumulate(mp.begin(),mp.end(),0.0,[](const double b, const Polygon &p){ return b+perimIncludingHoles(p);}); 
+  return mp.summary().perim + mp.summary().hole_perim;
 }
 
 double perimHoles(const MultiPolygon &mp){
-  return std::accumulate(mp.begin(),mp.end(),0.0,[](const double b, const Polygon &p){ return b+perimHoles(p);}); 
+  return mp.summary().hole_perim;
 }
 
 
@@ -361,15 +582,62 @@ unsigned holeCount(const MultiPolygon &mp){
   return std::accumulate(mp.begin(), mp.end(), 0, [](const double b, const Polygon &p){ return b+holeCount(p);});
 }
 
-double diameter(const Ring &r){
-  const auto &hull = r.getHull();
+//Rotating calipers: walk the hull's edges while advancing a second pointer to
+//the vertex farthest from the current edge. Every antipodal pair is visited,
+//and the diameter is always realised by one of them.
+std::pair<unsigned int, unsigned int> FarthestPairOnHull(const Points &hull){
+  //Ignore the closing point of a closed ring
+  unsigned int n = hull.size();
+  if(n>1 && hull.front().x==hull.back().x && hull.front().y==hull.back().y)
+    n--;
+
+  if(n==0)
+    throw std::runtime_error("Cannot find the most distant points of an empty hull!");
+  if(n<3)
+    return std::make_pair(0u, n-1);
+
+  //Twice the area of the triangle abc, which is proportional to the distance of
+  //c from the line through a and b. The absolute value makes this work for
+  //hulls of either orientation.
+  const auto tri_area = [](const Point2D &a, const Point2D &b, const Point2D &c){
+    return std::abs((b.x-a.x)*(c.y-a.y) - (b.y-a.y)*(c.x-a.x));
+  };
+
+  std::pair<unsigned int, unsigned int> best(0,0);
+  double maxdist = -1;
+  const auto consider = [&](const unsigned int a, const unsigned int b){
+    const double dist = EuclideanDistanceSquared(hull[a],hull[b]);
+    if(dist>maxdist){
+      maxdist = dist;
+      best    = std::make_pair(std::min(a,b), std::max(a,b));
+    }
+  };
+
+  unsigned int j = 1;
+  for(unsigned int i=0;i<n;i++){
+    const unsigned int ni = (i+1)%n;
+    while(tri_area(hull[i],hull[ni],hull[(j+1)%n]) > tri_area(hull[i],hull[ni],hull[j]))
+      j = (j+1)%n;
+    consider(i,j);
+    consider(ni,j);
+  }
+
+  return best;
+}
+
+//Distance between the most distant vertices of a convex hull. An empty hull
+//has no diameter; as with the all-pairs search this replaced, that gives 0
+//rather than an exception, so that one degenerate geometry doesn't abort a
+//whole run of scores.
+static double HullDiameter(const Ring &hull){
+  if(hull.empty())
+    return 0;
+  const auto pair = FarthestPairOnHull(hull.v);
+  return EuclideanDistance(hull.at(pair.first),hull.at(pair.second));
+}
 
-  //TODO: There's a faster way to do this
-  double maxdist = 0;
-  for(unsigned int i=0;i<hull.size();i++)
-  for(unsigned int j=i+1;j<hull.size();j++)
-    maxdist = std::max(maxdist,EuclideanDistance(hull.at(i),hull.at(j)));
-  return maxdist;
+double diameter(const Ring &r){
+  return HullDiameter(r.getHull());
 }
 
 double diameterOuter(const Polygon &p){
@@ -377,7 +645,9 @@ double diameterOuter(const Polygon &p){
 }
 
 double diameterOfEntireMultiPolygon(const MultiPolygon &mp){
-  return diameter(mp.getHull());
+  //The multipolygon's hull is already convex, so there's no need to take the
+  //hull of the hull
+  return HullDiameter(mp.getHull());
 }
 
 
@@ -416,33 +686,262 @@ cl::Paths ConvertToClipper(const MultiPolygon &mp, const bool reversed) {
 
 
 
+Circle::Circle(const Point2D &center0, const double radius0) : center(center0), radius(radius0) {}
+
+double Circle::area() const {
+  return M_PI*radius*radius;
+}
+
+
+
+Circle MinimumEnclosingCircle(const Points &pts){
+  if(pts.empty())
+    throw std::runtime_error("Cannot find the enclosing circle of no points!");
+
+  //Relative slack so that points which define a circle count as inside it
+  //despite rounding
+  const auto contains = [](const Circle &c, const Point2D &p){
+    return EuclideanDistanceSquared(c.center,p) <= c.radius*c.radius*(1+1e-12);
+  };
+  const auto from2 = [](const Point2D &a, const Point2D &b){
+    const Point2D mid((a.x+b.x)/2., (a.y+b.y)/2.);
+    return Circle(mid, EuclideanDistance(a,mid));
+  };
+  const auto from3 = [&](const Point2D &a, const Point2D &b, const Point2D &c){
+    const double bx = b.x-a.x;
+    const double by = b.y-a.y;
+    const double cx = c.x-a.x;
+    const double cy = c.y-a.y;
+    const double d  = 2*(bx*cy-by*cx);
+    //Collinear: the circle through the two farthest-apart points
+    if(d==0){
+      Circle best = from2(a,b);
+      for(const auto &cand: {from2(a,c), from2(b,c)})
+        if(cand.radius>best.radius)
+          best = cand;
+      return best;
+    }
+    const double b2 = bx*bx+by*by;
+    const double c2 = cx*cx+cy*cy;
+    const Point2D center(a.x+(cy*b2-by*c2)/d, a.y+(bx*c2-cx*b2)/d);
+    return Circle(center, EuclideanDistance(center,a));
+  };
+
+  //Welzl's algorithm runs in expected linear time on randomly-ordered points.
+  //A fixed seed keeps results reproducible.
+  Points p(pts);
+  std::mt19937 gen(1234);
+  std::shuffle(p.begin(), p.end(), gen);
+
+  Circle c(p[0],0);
+  for(unsigned int i=1;i<p.size();i++){
+    if(contains(c,p[i]))
+      continue;
+    //p[i] must be on the boundary
+    c = Circle(p[i],0);
+    for(unsigned int j=0;j<i;j++){
+      if(contains(c,p[j]))
+        continue;
+      //p[i] and p[j] must be on the boundary
+      c = from2(p[i],p[j]);
+      for(unsigned int k=0;k<j;k++)
+        if(!contains(c,p[k]))
+          c = from3(p[i],p[j],p[k]);
+    }
+  }
+
+  return c;
+}
+
+Circle MinimumEnclosingCircle(const Ring &r){
+  return MinimumEnclosingCircle(r.getHull().v);
+}
+
+Circle MinimumEnclosingCircle(const MultiPolygon &mp){
+  return MinimumEnclosingCircle(mp.getHull().v);
+}
+
+
+
+//Signed area of the intersection of a circle of radius r centered at the origin
+//with the triangle formed by the origin and the points a and b. Summing this
+//over a ring's edges gives the signed area of the ring's intersection with the
+//circle, in the same way the shoelace formula sums triangles to give the area
+//of the ring itself.
+static double CircleTriangleArea(const Point2D &a, const Point2D &b, const double r){
+  const auto cross = [](const Point2D &u, const Point2D &v){ return u.x*v.y - u.y*v.x; };
+  const auto dot   = [](const Point2D &u, const Point2D &v){ return u.x*v.x + u.y*v.y; };
+  //Area of the circular sector between the rays to u and v
+  const auto sector = [&](const Point2D &u, const Point2D &v){
+    return 0.5*r*r*std::atan2(cross(u,v), dot(u,v));
+  };
+
+  const double r2 = r*r;
+
+  //Both ends inside the circle: the whole triangle is
+  if(dot(a,a)<=r2 && dot(b,b)<=r2)
+    return 0.5*cross(a,b);
+
+  //Solve |a+t(b-a)|^2 = r^2 for the parameters at which the edge crosses the
+  //circle
+  const Point2D d(b.x-a.x, b.y-a.y);
+  const double A = dot(d,d);
+  if(A==0)
+    return 0;
+  const double B    = dot(a,d);
+  const double C    = dot(a,a)-r2;
+  const double disc = B*B-A*C;
+
+  //The edge's line misses the circle, or the edge lies entirely outside it
+  if(disc<=0)
+    return sector(a,b);
+  const double sq = std::sqrt(disc);
+  const double t1 = (-B-sq)/A;
+  const double t2 = (-B+sq)/A;
+  if(t2<=0 || t1>=1)
+    return sector(a,b);
+
+  //Outside-inside-outside: sector, triangle, sector. If an end is inside the
+  //circle its sector has zero angle.
+  const double s1 = std::max(t1,0.0);
+  const double s2 = std::min(t2,1.0);
+  const Point2D p1(a.x+s1*d.x, a.y+s1*d.y);
+  const Point2D p2(a.x+s2*d.x, a.y+s2*d.y);
+  return sector(a,p1) + 0.5*cross(p1,p2) + sector(p2,b);
+}
+
+static double CircleRingArea(const Circle &c, const Ring &r){
+  double area = 0;
+  for(unsigned int i=0;i<r.size();i++){
+    const auto &pa = r[i];
+    const auto &pb = r[(i+1)%r.size()];
+    area += CircleTriangleArea(
+      Point2D(pa.x-c.center.x, pa.y-c.center.y),
+      Point2D(pb.x-c.center.x, pb.y-c.center.y),
+      c.radius
+    );
+  }
+  return std::abs(area);
+}
+
+double IntersectionArea(const Circle &c, const MultiPolygon &mp){
+  double area = 0;
+  for(const auto &poly: mp){
+    //Polygons which can't reach the circle contribute nothing
+    const auto &bb = poly.summary().bbox;
+    if(bb.xmin()>c.center.x+c.radius || bb.xmax()<c.center.x-c.radius ||
+       bb.ymin()>c.center.y+c.radius || bb.ymax()<c.center.y-c.radius)
+      continue;
+    area += CircleRingArea(c, poly.at(0));
+    for(unsigned int i=1;i<poly.size();i++)
+      area -= CircleRingArea(c, poly.at(i));
+  }
+  return area;
+}
+
+
+
+//Clip the ring against each edge of the convex polygon in turn, keeping the
+//part on its inner side, and return the area of what is left. If the ring is
+//not convex the output may contain zero-width "bridges" along the clipping
+//edges, but these contribute nothing to the area. `in` and `out` are scratch
+//buffers reused between calls.
+static double ConvexClipRingArea(
+  const Points &convex,
+  const double orient,
+  const Ring   &r,
+  Points       &in,
+  Points       &out
+){
+  out.assign(r.begin(), r.end());
+  //Drop the closing point; the clipping below treats rings as implicitly
+  //closed
+  if(out.size()>1 && out.front().x==out.back().x && out.front().y==out.back().y)
+    out.pop_back();
+
+  for(unsigned int e=0;e+1<convex.size() && !out.empty();e++){
+    const auto &c1 = convex[e];
+    const auto &c2 = convex[e+1];
+    const double ex = c2.x-c1.x;
+    const double ey = c2.y-c1.y;
+    if(ex==0 && ey==0)
+      continue;
+    //Positive on the inner side of the edge
+    const auto side = [&](const Point2D &p){
+      return orient*(ex*(p.y-c1.y) - ey*(p.x-c1.x));
+    };
+
+    std::swap(in,out);
+    out.clear();
+    Point2D prev = in.back();
+    double  sprev = side(prev);
+    for(const auto &cur: in){
+      const double scur = side(cur);
+      if(scur>=0){
+        if(sprev<0){
+          const double t = sprev/(sprev-scur);
+          out.emplace_back(prev.x+t*(cur.x-prev.x), prev.y+t*(cur.y-prev.y));
+        }
+        out.push_back(cur);
+      } else if(sprev>0){
+        const double t = sprev/(sprev-scur);
+        out.emplace_back(prev.x+t*(cur.x-prev.x), prev.y+t*(cur.y-prev.y));
+      }
+      prev  = cur;
+      sprev = scur;
+    }
+  }
+
+  if(out.size()<3)
+    return 0;
+  double area = 0;
+  for(unsigned int i=0;i<out.size();i++){
+    const auto &a = out[i];
+    const auto &b = out[(i+1)%out.size()];
+    area += a.x*b.y - b.x*a.y;
+  }
+  return std::abs(area)/2;
+}
+
+double ConvexIntersectionArea(const Ring &convex, const MultiPolygon &mp){
+  Points hull(convex.begin(), convex.end());
+  if(hull.size()<3)
+    return 0;
+  if(hull.front().x!=hull.back().x || hull.front().y!=hull.back().y)
+    hull.push_back(hull.front());
+
+  //Which side of each edge is "inside" depends on the ring's winding
+  const double hull_signed_area = convex.summary().signed_area;
+  if(hull_signed_area==0)
+    return 0;
+  const double orient = hull_signed_area>0 ? 1 : -1;
+  const auto  &hbb    = convex.summary().bbox;
+
+  Points in, out;
+  double area = 0;
+  for(const auto &poly: mp){
+    //Polygons which can't reach the convex ring contribute nothing
+    const auto &bb = poly.summary().bbox;
+    if(bb.xmin()>hbb.xmax() || bb.xmax()<hbb.xmin() ||
+       bb.ymin()>hbb.ymax() || bb.ymax()<hbb.ymin())
+      continue;
+    area += ConvexClipRingArea(hull, orient, poly.at(0), in, out);
+    for(unsigned int i=1;i<poly.size();i++)
+      area -= ConvexClipRingArea(hull, orient, poly.at(i), in, out);
+  }
+  return area;
+}
+
+
+
 MultiPolygon GetBoundingCircle(const MultiPolygon &mp){
   //Number of unique points from which to construct the circle. The circle will
   //have one more point of than this in order to form a closed ring).
   const int CIRCLE_PT_COUNT = 1000;
 
-  std::vector< std::vector<double> > pts;
-  for(const auto &poly: mp)
-  for(const auto &ring: poly)
-  for(const auto &pt: ring)
-    pts.push_back(std::vector<double>({{pt.x,pt.y}}));
-
-  // define the types of iterators through the points and their coordinates
-  // ----------------------------------------------------------------------
-  typedef std::vector<std::vector<double> >::const_iterator PointIterator; 
-  typedef std::vector<double>::const_iterator CoordIterator;
-
-  // create an instance of Miniball
-  // ------------------------------
-  typedef Miniball::
-    Miniball <Miniball::CoordAccessor<PointIterator, CoordIterator> > 
-    MB;
-
-  MB mb (2, pts.begin(), pts.end());
-  
-  const Point2D midpt(mb.center()[0], mb.center()[1]);
-  const double radius = std::sqrt(mb.squared_radius());
-  //"Computation time was "<< mb.get_time() << " seconds\n";
+  const auto mec = MinimumEnclosingCircle(mp);
+  const Point2D &midpt = mec.center;
+  const double radius  = mec.radius;
 
   MultiPolygon circle;
   circle.emplace_back();             //Make a polygon
@@ -515,11 +1014,11 @@ unsigned PointCount<Ring>(const Ring &r){
 Point2D CentroidPTSH(const MultiPolygon &mp){
   Point2D centroid(0,0);
   unsigned int ptcount = 0;
-  for(const auto &poly: mp)
-  for(const auto &pt: poly.at(0)){
-    centroid.x += pt.x;
-    centroid.y += pt.y;
-    ptcount++;
+  for(const auto &poly: mp){
+    const auto sum = CoordinateSum(poly.at(0).v.data(), poly.at(0).size());
+    centroid.x += sum.x;
+    centroid.y += sum.y;
+    ptcount    += poly.at(0).size();
   }
 
   centroid.x /= ptcount;
@@ -7,6 +7,7 @@
 #include <string>
 #include <limits>
 #include "Props.hpp"
+#include "lazy_cache.hpp"
 #include "lib/clipper.hpp"
 #include "lib/iterator_tpl.h"
 #include <iostream>
@@ -56,21 +57,65 @@ class Point2D {
   Point2D(double x0, double y0);
 };
 
+///Quantities every score needs, gathered in a single pass over a geometry's
+///coordinates. For a Ring the hole fields are zero. For Polygons and
+///MultiPolygons `area` and `perim` describe the outer rings only.
+class GeometrySummary {
+ public:
+  double      area         = 0; ///< Unsigned area of the outer ring(s), holes included
+  double      signed_area  = 0; ///< Signed area of the outer ring(s); positive is counter-clockwise
+  double      perim        = 0; ///< Perimeter of the outer ring(s)
+  double      hole_area    = 0; ///< Total unsigned area of the holes
+  double      hole_perim   = 0; ///< Total perimeter of the holes
+  unsigned    vertex_count = 0; ///< Number of vertices in all rings
+  BoundingBox bbox;
+  GeometrySummary& operator+=(const GeometrySummary &o);
+};
+
+//Geometries cache values derived from their coordinates (hulls, summaries).
+//The caches fill themselves on first use and may be read from many threads at
+//once. The library's own modifiers (reverse(), toRadians(), ...) drop them, as
+//do the vector members Ring, Polygon, and MultiPolygon expose: push_back(),
+//emplace_back(), and the non-const at(), operator[], front(), back(), and
+//iterators each clear the cache of the geometry they are called on. So
+//`mp.at(0).at(0).push_back(p)` leaves no stale values behind.
+//
+//Edits which bypass those members still need an explicit clearCache() on every
+//level they affect: writes through `v`, and writes through a reference to a
+//nested geometry which was taken before its parent's cache was next filled
+//(e.g. `auto &ring = mp.at(0).at(0); mp.summary(); ring.push_back(p);` leaves
+//mp's summary stale).
+//
+//Clearing a cache never frees the value it held: a reference returned by
+//getHull() or summary() stays valid for as long as the geometry lives, though
+//after an edit it describes the geometry as it was. Still, non-const access
+//forces values to be recomputed, so share geometries between threads through
+//const references.
+
 class Ring {
  public:
   Points v;
   Ring() = default;
   Ring(const std::vector<Point2D> &ptvec);
-  mutable std::vector<Point2D> hull;
-  Ring getHull() const;
+  const Ring& getHull() const;
+  const GeometrySummary& summary() const;
+  void clearCache();
   ClipperLib::Paths clipper_paths;
-  EXPOSE_STL_VECTOR(v);
+  EXPOSE_STL_VECTOR_CACHED(v, clearCache);
+ private:
+  LazyCache<Ring>            hull_cache;
+  LazyCache<GeometrySummary> summary_cache;
 };
 
 class Polygon {
  public:
   Rings v;
-  EXPOSE_STL_VECTOR(v);
+  const GeometrySummary& summary() const;
+  void clearCache();
+  EXPOSE_STL_VECTOR_CACHED(v, clearOwnCache);
+ private:
+  LazyCache<GeometrySummary> summary_cache;
+  void clearOwnCache(); //Only this polygon's values, not its rings'
 };
 
 class MultiPolygon {
@@ -82,7 +127,6 @@ class MultiPolygon {
   //established by Densify(). Can be used to determine whether or not the MP has
   //been densified.
   double densified = 0; 
-  mutable Ring hull;
   const Ring& getHull() const;
   void toRadians();
   void toDegrees();
@@ -90,12 +134,19 @@ class MultiPolygon {
   ClipperLib::Paths clipper_paths;
   void reverse();
   BoundingBox bbox() const;
-  EXPOSE_STL_VECTOR(v);
+  const GeometrySummary& summary() const;
+  void clearCache();
+  EXPOSE_STL_VECTOR_CACHED(v, clearOwnCache);
 
   std::vector<unsigned int> neighbours;
   typedef std::pair<unsigned int, double> parent_t;
   std::vector<parent_t> parents;
   std::vector<parent_t> children;
+
+ private:
+  LazyCache<Ring>            hull_cache;
+  LazyCache<GeometrySummary> summary_cache;
+  void clearOwnCache(); //Only this multipolygon's values, not its polygons'
 };
 
 class GeoCollection {
@@ -149,6 +200,10 @@ unsigned holeCount(const MultiPolygon &mp);
 
 Point2D CentroidPTSH(const MultiPolygon &mp);
 
+///Convex hull of the n points of a ring, closed and counter-clockwise. This is
+///what Ring::getHull() caches; it is exposed for coordinates stored elsewhere.
+Points ConvexHull(const Point2D *const pts, const size_t n);
+
 
 template<class T>
 unsigned PointCount(const T &geom){
@@ -168,49 +223,52 @@ unsigned PointCount<Ring>(const Ring &r);
 cl::Paths ConvertToClipper(const Ring &ring, const bool reversed);
 cl::Paths ConvertToClipper(const MultiPolygon &mp, const bool reversed);
 
+//IntersectionArea() for pairs of polygons lives in prepared_polygon.hpp
 
-template<class T, class U>
-double IntersectionArea(const T &a, const U &b) {
-  if(a.clipper_paths.empty())
-    throw std::runtime_error("Must precalculate clipper paths!");
-  if(b.clipper_paths.empty())
-    throw std::runtime_error("Must precalculate clipper paths!");
-
-  cl::Clipper clpr;
-  clpr.AddPaths(a.clipper_paths, cl::ptSubject, true);
-  clpr.AddPaths(b.clipper_paths, cl::ptClip, true);
-  cl::Paths solution;
-  clpr.Execute(cl::ctIntersection, solution, cl::pftEvenOdd, cl::pftEvenOdd);
-
-  double area = 0;
-  for(const auto &path: solution)
-    area += cl::Area(path);
-  return area;
-}
 
 
+///Indices of the two most distant vertices of a convex hull, found with
+///rotating calipers in O(h). The hull may be open or closed.
+std::pair<unsigned int, unsigned int> FarthestPairOnHull(const Points &hull);
 
 template<class T>
 std::pair<Point2D, Point2D> MostDistantPoints(const T &geom){
   //We'll use the Convex Hull to find the two most distant points
   const auto &hull = geom.getHull();
 
-  std::pair<unsigned int, unsigned int> idx_maxpts;
-  double maxdist = 0;
-
-  //TODO: There's a faster way to do this  
-  for(unsigned int i=0;i<hull.size();i++)
-  for(unsigned int j=i+1;j<hull.size();j++){
-    const double dist = EuclideanDistance(hull.at(i),hull.at(j));
-    if(dist>maxdist){
-      idx_maxpts = std::make_pair(i,j);
-      maxdist    = dist;
-    }
-  }
+  const auto idx_maxpts = FarthestPairOnHull(hull.v);
 
   return std::make_pair(hull.at(idx_maxpts.first), hull.at(idx_maxpts.second));
 }
 
+class Circle {
+ public:
+  Point2D center;
+  double  radius;
+  Circle() = default;
+  Circle(const Point2D &center0, const double radius0);
+  double area() const;
+};
+
+///Smallest circle containing all the points, by Welzl's algorithm (in its
+///iterative, randomized-incremental form). Expected O(n).
+Circle MinimumEnclosingCircle(const Points &pts);
+///Smallest circle which contains all of the ring's points. Only the ring's
+///(cached) convex hull needs to be considered.
+Circle MinimumEnclosingCircle(const Ring &r);
+///Smallest circle which contains all of the multipolygon's points
+Circle MinimumEnclosingCircle(const MultiPolygon &mp);
+
+///Exact area of the intersection of a circle and a multipolygon (with holes).
+///Computed analytically, edge by edge, so no circle polygon is built.
+double IntersectionArea(const Circle &c, const MultiPolygon &mp);
+
+///Area of the intersection of a convex ring (such as a convex hull) and a
+///multipolygon (with holes). Each of the multipolygon's rings is clipped against
+///the convex ring, Sutherland-Hodgman style, entirely in doubles. The result is
+///only meaningful if `convex` really is convex.
+double ConvexIntersectionArea(const Ring &convex, const MultiPolygon &mp);
+
 MultiPolygon GetBoundingCircle(const MultiPolygon &mp);
 MultiPolygon GetBoundingCircleMostDistant(const MultiPolygon &mp);
 
@@ -0,0 +1,380 @@
+#ifndef _hilbert_rtree_hpp_
+#define _hilbert_rtree_hpp_
+
+#include "geom.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+namespace complib {
+
+typedef std::vector< std::pair<unsigned int, BoundingBox> > idbb;
+
+///Position of (x,y) along a Hilbert curve filling a 2^16 x 2^16 grid
+inline uint32_t HilbertKey(uint32_t x, uint32_t y){
+  const uint32_t n = 1u<<16;
+  uint32_t d = 0;
+  for(uint32_t s=n/2;s>0;s/=2){
+    const uint32_t rx = (x & s)>0;
+    const uint32_t ry = (y & s)>0;
+    d += s*s*((3*rx)^ry);
+    //Rotate the quadrant so that the curve's sub-pieces join up
+    if(ry==0){
+      if(rx==1){
+        x = n-1-x;
+        y = n-1-y;
+      }
+      std::swap(x,y);
+    }
+  }
+  return d;
+}
+
+///Sort `v` using every OpenMP thread: the pieces are sorted independently and
+///then merged pairwise. Small inputs are just handed to std::sort.
+template<class T>
+void ParallelSort(std::vector<T> &v){
+#ifdef _OPENMP
+  const int pieces = omp_get_max_threads();
+#else
+  const int pieces = 1;
+#endif
+  if(pieces==1 || v.size()<(size_t)100000){
+    std::sort(v.begin(), v.end());
+    return;
+  }
+
+  std::vector<size_t> bounds(pieces+1);
+  for(int i=0;i<=pieces;i++)
+    bounds[i] = v.size()*i/pieces;
+
+  #pragma omp parallel for
+  for(int i=0;i<pieces;i++)
+    std::sort(v.begin()+bounds[i], v.begin()+bounds[i+1]);
+
+  for(int width=1;width<pieces;width*=2){
+    #pragma omp parallel for
+    for(int i=0;i<pieces;i+=2*width){
+      if(i+width>=pieces)
+        continue;
+      std::inplace_merge(
+        v.begin()+bounds[i],
+        v.begin()+bounds[i+width],
+        v.begin()+bounds[std::min(i+2*width,pieces)]
+      );
+    }
+  }
+}
+
+///Indices 0..n-1 sorted by the Hilbert keys of the centers of the boxes
+///`box(i)`, scaled to the extent of all the boxes. Boxes which are close
+///together in space end up close together in the ordering. Keys are computed
+///and sorted in parallel, in memory.
+template<class F>
+std::vector<unsigned int> HilbertOrder(const size_t n, F &&box){
+  double xmin =  std::numeric_limits<double>::infinity();
+  double ymin =  std::numeric_limits<double>::infinity();
+  double xmax = -std::numeric_limits<double>::infinity();
+  double ymax = -std::numeric_limits<double>::infinity();
+  #pragma omp parallel for reduction(min:xmin,ymin) reduction(max:xmax,ymax)
+  for(long i=0;i<(long)n;i++){
+    const BoundingBox &bb = box(i);
+    xmin = std::min(xmin,bb.min[0]);
+    ymin = std::min(ymin,bb.min[1]);
+    xmax = std::max(xmax,bb.max[0]);
+    ymax = std::max(ymax,bb.max[1]);
+  }
+  const double width     = xmax-xmin;
+  const double height    = ymax-ymin;
+  const double max_coord = (1u<<16)-1;
+
+  //The key goes in the high bits and the index in the low bits, so sorting
+  //plain integers sorts by key
+  std::vector<uint64_t> keys(n);
+  #pragma omp parallel for
+  for(long i=0;i<(long)n;i++){
+    const BoundingBox &bb = box(i);
+    const double cx = (bb.min[0]+bb.max[0])/2;
+    const double cy = (bb.min[1]+bb.max[1])/2;
+    const uint32_t hx = width ==0 ? 0 : (uint32_t)(max_coord*(cx-xmin)/width);
+    const uint32_t hy = height==0 ? 0 : (uint32_t)(max_coord*(cy-ymin)/height);
+    keys[i] = ((uint64_t)HilbertKey(hx,hy)<<32) | (uint64_t)i;
+  }
+  ParallelSort(keys);
+
+  std::vector<unsigned int> order(n);
+  #pragma omp parallel for
+  for(long i=0;i<(long)n;i++)
+    order[i] = (unsigned int)(keys[i] & 0xFFFFFFFFu);
+  return order;
+}
+
+///Static R-tree built in one pass by sorting boxes along a Hilbert curve and
+///packing them, node_size at a time, into parents. The tree is stored as flat
+///arrays: all of the leaves, followed by each level of parents, ending with the
+///root. Once built it is never modified, so any number of threads may query it
+///at once without locking.
+class PackedHilbertRTree {
+ public:
+  static constexpr unsigned int node_size = 16;
+  ///Most levels a tree can have: with 32-bit ids there are at most 2^32 leaves,
+  ///which node_size-way parents reduce to a root in 8 more levels
+  static constexpr unsigned int max_levels = 9;
+
+  PackedHilbertRTree() = default;
+
+  explicit PackedHilbertRTree(const idbb &entries){
+    if(entries.empty())
+      return;
+
+    const auto order = HilbertOrder(entries.size(), [&](const size_t i) -> const BoundingBox& {
+      return entries[i].second;
+    });
+
+    //Each level shrinks by a factor of node_size, so the whole tree is at most
+    //n*node_size/(node_size-1) nodes, plus one per level for the remainders
+    const size_t capacity = entries.size() + entries.size()/(node_size-1) + 16;
+    own_boxes.reserve(capacity);
+    own_ids.reserve(capacity);
+
+    own_boxes.resize(entries.size());
+    own_ids.resize(entries.size());
+    #pragma omp parallel for
+    for(long i=0;i<(long)order.size();i++){
+      own_boxes[i] = entries[order[i]].second;
+      own_ids[i]   = entries[order[i]].first;
+    }
+    own_level_ends.push_back(own_boxes.size());
+
+    //Group each level's nodes into parents until only the root remains
+    size_t begin = 0;
+    size_t end   = own_boxes.size();
+    while(end-begin>1){
+      const size_t parents = (end-begin+node_size-1)/node_size;
+      own_boxes.resize(end+parents);
+      own_ids.resize(end+parents);
+      #pragma omp parallel for
+      for(long p=0;p<(long)parents;p++){
+        const size_t first = begin+p*node_size;
+        BoundingBox parent;
+        for(size_t c=first;c<std::min(end,first+node_size);c++)
+          extendBox(parent, own_boxes[c]);
+        own_boxes[end+p] = parent;
+        own_ids[end+p]   = (unsigned int)first;
+      }
+      begin = end;
+      end   = own_boxes.size();
+      own_level_ends.push_back(end);
+    }
+
+    boxes      = own_boxes.data();
+    ids        = own_ids.data();
+    level_ends = own_level_ends.data();
+    num_nodes  = own_boxes.size();
+    num_levels = own_level_ends.size();
+  }
+
+  ///A tree whose arrays live in memory owned by something else, such as a
+  ///mapped file. `keep_alive` holds on to that memory for the tree's lifetime.
+  PackedHilbertRTree(
+    const BoundingBox  *boxes0,
+    const unsigned int *ids0,
+    const size_t        num_nodes0,
+    const uint64_t     *level_ends0,
+    const size_t        num_levels0,
+    std::shared_ptr<const void> keep_alive
+  ) : mapping(keep_alive), boxes(boxes0), ids(ids0), level_ends(level_ends0),
+      num_nodes(num_nodes0), num_levels(num_levels0) {}
+
+  //The views below may point into the tree's own storage, so it can't be
+  //copied
+  PackedHilbertRTree(const PackedHilbertRTree&) = delete;
+  PackedHilbertRTree& operator=(const PackedHilbertRTree&) = delete;
+
+  ///Number of boxes in the tree
+  size_t size() const {
+    return num_levels==0 ? 0 : level_ends[0];
+  }
+
+  bool empty() const {
+    return num_nodes==0;
+  }
+
+  //Raw arrays, for serialisation
+  const BoundingBox*  nodeBoxes () const { return boxes;      }
+  const unsigned int* nodeIds   () const { return ids;        }
+  const uint64_t*     levelEnds () const { return level_ends; }
+  size_t              nodeCount () const { return num_nodes;  }
+  size_t              levelCount() const { return num_levels; }
+
+  ///Call `visit(id)` for the id of every box which intersects (or touches) `bb`
+  template<class F>
+  void query(const BoundingBox &bb, F &&visit) const {
+    if(num_nodes==0)
+      return;
+
+    const size_t root = num_nodes-1;
+    if(!overlaps(boxes[root],bb))
+      return;
+    if(num_levels==1){
+      visit(ids[root]);
+      return;
+    }
+
+    //Depth-first traversal. A node at a given level expands to at most
+    //node_size children, and there are at most max_levels levels, so the stack
+    //has a fixed bound.
+    std::pair<size_t, unsigned int> stack[max_levels*node_size];
+    unsigned int top = 0;
+    stack[top++] = std::make_pair(root, (unsigned int)num_levels-1);
+    while(top>0){
+      const auto node  = stack[--top];
+      const size_t first = ids[node.first];
+      const size_t last  = std::min<size_t>(first+node_size, level_ends[node.second-1]);
+      const bool   leaves = node.second==1;
+      for(size_t c=first;c<last;c++){
+        if(!overlaps(boxes[c],bb))
+          continue;
+        if(leaves)
+          visit(ids[c]);
+        else
+          stack[top++] = std::make_pair(c, node.second-1);
+      }
+    }
+  }
+
+  ///A node of the tree: the position of its box and its level (0 for leaves)
+  class Node {
+   public:
+    size_t       pos;
+    unsigned int level;
+  };
+
+  Node root() const {
+    return Node{num_nodes-1, (unsigned int)num_levels-1};
+  }
+
+  ///Call `visit(id_a, id_b)` for every pair of boxes, one from the subtree of
+  ///`a` below `na` and one from the subtree of `b` below `nb`, which intersect.
+  ///Both trees are descended together, so whole subtrees which can't overlap
+  ///are skipped at once.
+  template<class F>
+  static void join(
+    const PackedHilbertRTree &a, const Node na,
+    const PackedHilbertRTree &b, const Node nb,
+    F &&visit
+  ){
+    std::vector< std::pair<Node,Node> > stack;
+    stack.emplace_back(na,nb);
+    while(!stack.empty()){
+      const auto np = stack.back();
+      stack.pop_back();
+      const Node &x = np.first;
+      const Node &y = np.second;
+      if(!overlaps(a.boxes[x.pos],b.boxes[y.pos]))
+        continue;
+      if(x.level==0 && y.level==0){
+        visit(a.ids[x.pos], b.ids[y.pos]);
+      } else if(x.level>=y.level){
+        //Descend the taller side first so that the two sides stay at similar
+        //scales
+        a.forEachChild(x, [&](const Node &c){
+          if(overlaps(a.boxes[c.pos],b.boxes[y.pos]))
+            stack.emplace_back(c,y);
+        });
+      } else {
+        b.forEachChild(y, [&](const Node &c){
+          if(overlaps(a.boxes[x.pos],b.boxes[c.pos]))
+            stack.emplace_back(x,c);
+        });
+      }
+    }
+  }
+
+  ///Pairs of nodes, one from each tree, whose subtrees together contain every
+  ///intersecting pair of boxes. The trees are expanded from their roots until
+  ///there are at least `min_pairs` candidates (or only leaves remain), so the
+  ///pairs can be handed out as independent units of work to join().
+  static std::vector< std::pair<Node,Node> > joinFrontier(
+    const PackedHilbertRTree &a,
+    const PackedHilbertRTree &b,
+    const size_t min_pairs
+  ){
+    std::vector< std::pair<Node,Node> > frontier;
+    if(a.empty() || b.empty())
+      return frontier;
+    frontier.emplace_back(a.root(), b.root());
+    while(frontier.size()<min_pairs){
+      std::vector< std::pair<Node,Node> > next;
+      bool expanded = false;
+      for(const auto &np: frontier){
+        const Node &x = np.first;
+        const Node &y = np.second;
+        if(x.level==0 && y.level==0){
+          next.push_back(np);
+        } else if(x.level>=y.level){
+          expanded = true;
+          a.forEachChild(x, [&](const Node &c){
+            if(overlaps(a.boxes[c.pos],b.boxes[y.pos]))
+              next.emplace_back(c,y);
+          });
+        } else {
+          expanded = true;
+          b.forEachChild(y, [&](const Node &c){
+            if(overlaps(a.boxes[x.pos],b.boxes[c.pos]))
+              next.emplace_back(x,c);
+          });
+        }
+      }
+      frontier.swap(next);
+      if(!expanded)
+        break;
+    }
+    return frontier;
+  }
+
+ private:
+  //Storage for trees built in memory
+  std::vector<BoundingBox>  own_boxes;
+  std::vector<unsigned int> own_ids;
+  std::vector<uint64_t>     own_level_ends;
+  //Storage for trees which live elsewhere
+  std::shared_ptr<const void> mapping;
+
+  //Views of whichever storage is in use
+  const BoundingBox  *boxes      = nullptr; ///< Leaves, then each level of parents, ending at the root
+  const unsigned int *ids        = nullptr; ///< For leaves the box's id; for parents the index of its first child
+  const uint64_t     *level_ends = nullptr; ///< One past the last node of each level, leaves first
+  size_t              num_nodes  = 0;
+  size_t              num_levels = 0;
+
+  template<class F>
+  void forEachChild(const Node &n, F &&f) const {
+    const size_t first = ids[n.pos];
+    const size_t last  = std::min<size_t>(first+node_size, level_ends[n.level-1]);
+    for(size_t c=first;c<last;c++)
+      f(Node{c, n.level-1});
+  }
+
+  static bool overlaps(const BoundingBox &a, const BoundingBox &b){
+    return a.min[0]<=b.max[0] && b.min[0]<=a.max[0]
+        && a.min[1]<=b.max[1] && b.min[1]<=a.max[1];
+  }
+
+  static void extendBox(BoundingBox &a, const BoundingBox &b){
+    a.min[0] = std::min(a.min[0],b.min[0]);
+    a.min[1] = std::min(a.min[1],b.min[1]);
+    a.max[0] = std::max(a.max[0],b.max[0]);
+    a.max[1] = std::max(a.max[1],b.max[1]);
+  }
+};
+
+}
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef _lazy_cache_hpp_
+#define _lazy_cache_hpp_
+
+#include <atomic>
+
+namespace complib {
+
+///Holds a value derived from a geometry which is computed the first time it is
+///asked for. Concurrent readers are safe: each computes the value into its own
+///storage and then tries to publish it with a single atomic compare-and-swap.
+///The first to publish wins and everyone else discards their copy, so all
+///readers see the same object. No locks are held while computing, so a cache
+///may freely consult other caches (e.g. a MultiPolygon's summary built from its
+///Polygons' summaries).
+///
+///clear() does not free the value: it is retired, onto a lock-free list, and
+///freed only when the cache is destroyed or assigned to. So a reference handed
+///out by get() stays valid (if stale) for as long as the cache lives, even if
+///another thread clears the cache meanwhile. Assignment is not safe to run
+///concurrently with readers; it is only used when the geometry as a whole is
+///being replaced, which already requires exclusive access.
+///
+///Values are kept behind a pointer so that an empty cache costs only two words
+///and so that T may be the type which holds the cache (e.g. a Ring's hull is
+///itself a Ring).
+template<class T>
+class LazyCache {
+ public:
+  LazyCache() = default;
+
+  LazyCache(const LazyCache &o) : ptr(o.copyValue()) {}
+
+  LazyCache(LazyCache &&o) noexcept : ptr(o.ptr.exchange(nullptr)), retired(o.retired.exchange(nullptr)) {}
+
+  ~LazyCache(){
+    delete ptr.load(std::memory_order_acquire);
+    freeRetired();
+  }
+
+  LazyCache& operator=(const LazyCache &o){
+    if(this!=&o)
+      reset(o.copyValue());
+    return *this;
+  }
+
+  LazyCache& operator=(LazyCache &&o) noexcept {
+    if(this!=&o){
+      reset(o.ptr.exchange(nullptr));
+      retire(o.retired.exchange(nullptr));
+    }
+    return *this;
+  }
+
+  ///Return the cached value, calling `compute()` to produce it if necessary
+  template<class F>
+  const T& get(F &&compute) const {
+    const Node *cur = ptr.load(std::memory_order_acquire);
+    if(cur)
+      return cur->value;
+
+    Node *mine = new Node{compute(), nullptr};
+    Node *expected = nullptr;
+    if(ptr.compare_exchange_strong(expected, mine, std::memory_order_acq_rel, std::memory_order_acquire))
+      return mine->value;
+
+    //Another thread got there first
+    delete mine;
+    return expected->value;
+  }
+
+  bool valid() const {
+    return ptr.load(std::memory_order_acquire)!=nullptr;
+  }
+
+  ///Forget the value, so that the next get() computes it afresh. The old value
+  ///is retired rather than freed.
+  void clear(){
+    retire(ptr.exchange(nullptr, std::memory_order_acq_rel));
+  }
+
+ private:
+  class Node {
+   public:
+    T     value;
+    Node *next; ///< Next retired value
+  };
+
+  mutable std::atomic<Node*> ptr{nullptr};
+  std::atomic<Node*>         retired{nullptr};
+
+  Node* copyValue() const {
+    const Node *cur = ptr.load(std::memory_order_acquire);
+    return cur ? new Node{cur->value, nullptr} : nullptr;
+  }
+
+  //Push a chain of nodes onto the retired list
+  void retire(Node *first){
+    if(!first)
+      return;
+    Node *last = first;
+    while(last->next)
+      last = last->next;
+    last->next = retired.load(std::memory_order_relaxed);
+    while(!retired.compare_exchange_weak(last->next, first, std::memory_order_release, std::memory_order_relaxed)) {}
+  }
+
+  void freeRetired(){
+    Node *n = retired.exchange(nullptr, std::memory_order_acquire);
+    while(n){
+      Node *next = n->next;
+      delete n;
+      n = next;
+    }
+  }
+
+  //Replace the value outright, freeing the old one and every retired one
+  void reset(Node *p){
+    delete ptr.exchange(p, std::memory_order_acq_rel);
+    freeRetired();
+  }
+};
+}
+
+#endif
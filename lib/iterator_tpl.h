@@ -1,6 +1,8 @@
 #ifndef _iterator_tpl_h_
 #define _iterator_tpl_h_
 
+#include <utility>
+
 namespace iterator_tpl {
 
 #define EXPOSE_STL_VECTOR(V) \
@@ -30,17 +32,60 @@ namespace iterator_tpl {
   decltype(V)::size_type size()  const noexcept { return V.size();  } \
   bool                   empty() const noexcept { return V.empty(); }
 
-#define EXPOSE_STL_MODIFIERS(V)                                             \
-  void push_back(const decltype(V)::value_type &val ) { V.push_back(val); } \
-  void push_back(      decltype(V)::value_type &&val) { V.push_back(val); } \
-  template< class... Args >                                                 \
-  void emplace_back(Args&&... args) { V.emplace_back(args...); }
+#define EXPOSE_STL_MODIFIERS(V)                                                        \
+  void push_back(const decltype(V)::value_type &val ) { V.push_back(val);            } \
+  void push_back(      decltype(V)::value_type &&val) { V.push_back(std::move(val)); } \
+  template< class... Args >                                                            \
+  void emplace_back(Args&&... args) { V.emplace_back(std::forward<Args>(args)...); }   \
+  void reserve(decltype(V)::size_type n) { V.reserve(n); }
 
 #define EXPOSE_STL_FRONT_BACK(V)                                   \
   decltype(V)::reference       front()       { return V.front(); } \
   decltype(V)::const_reference front() const { return V.front(); } \
   decltype(V)::reference       back ()       { return V.back (); } \
-  decltype(V)::const_reference back () const { return V.back (); } 
+  decltype(V)::const_reference back () const { return V.back (); }
+
+
+
+// As EXPOSE_STL_VECTOR, for classes which cache values derived from V. Every
+// member which hands out mutable access to V (modifiers, non-const iterators
+// and accessors) first calls the class's member function CLEAR() to drop those
+// values. Const members leave the cache alone.
+#define EXPOSE_STL_VECTOR_CACHED(V, CLEAR) \
+  EXPOSE_STL_ITERATORS_CACHED(V, CLEAR)    \
+  EXPOSE_STL_ACCESORS_CACHED(V, CLEAR)     \
+  EXPOSE_STL_SIZE(V)                       \
+  EXPOSE_STL_MODIFIERS_CACHED(V, CLEAR)    \
+  EXPOSE_STL_FRONT_BACK_CACHED(V, CLEAR)
+
+#define EXPOSE_STL_ITERATORS_CACHED(V, CLEAR)                                          \
+  decltype(V)::iterator               begin ()       { CLEAR(); return V.begin (); } \
+  decltype(V)::iterator               end   ()       { CLEAR(); return V.end   (); } \
+  decltype(V)::const_iterator         begin () const {          return V.begin (); } \
+  decltype(V)::const_iterator         end   () const {          return V.end   (); } \
+  decltype(V)::reverse_iterator       rbegin()       { CLEAR(); return V.rbegin(); } \
+  decltype(V)::reverse_iterator       rend  ()       { CLEAR(); return V.rend  (); } \
+  decltype(V)::const_reverse_iterator rbegin() const {          return V.rbegin(); } \
+  decltype(V)::const_reverse_iterator rend  () const {          return V.rend  (); } \
+
+#define EXPOSE_STL_ACCESORS_CACHED(V, CLEAR)                                                               \
+  decltype(V)::reference       at        (decltype(V)::size_type pos)       { CLEAR(); return V.at(pos); } \
+  decltype(V)::const_reference at        (decltype(V)::size_type pos) const {          return V.at(pos); } \
+  decltype(V)::reference       operator[](decltype(V)::size_type pos)       { CLEAR(); return V[pos];    } \
+  decltype(V)::const_reference operator[](decltype(V)::size_type pos) const {          return V[pos];    } \
+
+#define EXPOSE_STL_MODIFIERS_CACHED(V, CLEAR)                                                   \
+  void push_back(const decltype(V)::value_type &val ) { CLEAR(); V.push_back(val);            } \
+  void push_back(      decltype(V)::value_type &&val) { CLEAR(); V.push_back(std::move(val)); } \
+  template< class... Args >                                                                     \
+  void emplace_back(Args&&... args) { CLEAR(); V.emplace_back(std::forward<Args>(args)...); }   \
+  void reserve(decltype(V)::size_type n) { V.reserve(n); }
+
+#define EXPOSE_STL_FRONT_BACK_CACHED(V, CLEAR)                              \
+  decltype(V)::reference       front()       { CLEAR(); return V.front(); } \
+  decltype(V)::const_reference front() const {          return V.front(); } \
+  decltype(V)::reference       back ()       { CLEAR(); return V.back (); } \
+  decltype(V)::const_reference back () const {          return V.back (); }
 
 
 
@@ -2,9 +2,13 @@
 #include "geom.hpp"
 #include "lib/nanoflann.hpp"
 #include "SpIndex.hpp"
+#include "prepared_polygon.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
 
 namespace complib {
 
@@ -47,8 +51,6 @@ owner_point_vec_t GetDensifiedBorders(const GeoCollection &gc, const double maxd
         si++;
         st = si*step;
       } while (st<1);
-
-      temp.first.emplace_back(mpi);
     }
   }
 
@@ -57,6 +59,20 @@ owner_point_vec_t GetDensifiedBorders(const GeoCollection &gc, const double maxd
 
 
 
+//GetDensifiedBorders emits each unit's points contiguously and in unit order.
+//Return offsets such that unit u's points are those from offsets[u] up to
+//offsets[u+1].
+static std::vector<size_t> OwnerOffsets(const ownervec_t &owners, const size_t num_units){
+  std::vector<size_t> offsets(num_units+1, 0);
+  for(const auto &o: owners)
+    offsets[o+1]++;
+  for(size_t u=1;u<offsets.size();u++)
+    offsets[u] += offsets[u-1];
+  return offsets;
+}
+
+
+
 ///////////////////////////////////////////////////////////
 //The following is copied verbatim from a nanoflann example
 
@@ -138,21 +154,55 @@ struct KDTreeVectorOfVectorsAdaptor {
 //////////////////////////////////////////////////////////////////
 //Okay, back to my stuff
 
+//nanoflann result set which looks for any point belonging to a particular
+//owner within a radius of the query. The search stops at the first such point,
+//so a kd-tree of every unit's points can answer "is this point near unit X?"
+class OwnerWithinRadius {
+ public:
+  bool found = false;
+
+  OwnerWithinRadius(const ownervec_t &owners0, const unsigned int owner0, const double radius_sq0)
+    : owners(owners0), owner(owner0), radius_sq(radius_sq0) {}
+
+  //Distances given to us are squared, as is the radius
+  double worstDist() const { return radius_sq; }
+  bool   full()      const { return true;      }
+
+  bool addPoint(const double dist, const size_t index){
+    if(dist<radius_sq && owners[index]==owner){
+      found = true;
+      return false; //Stop searching
+    }
+    return true;
+  }
+
+ private:
+  const ownervec_t   &owners;
+  const unsigned int  owner;
+  const double        radius_sq;
+};
+
+
+static void WriteNeighbourProps(GeoCollection &gc){
+  for(auto &unit: gc){
+    unit.props["NEIGHNUM"]   = std::to_string(unit.neighbours.size());
+    unit.props["NEIGHBOURS"] = "";
+    for(const auto &n: unit.neighbours)
+      unit.props["NEIGHBOURS"] += std::to_string(n) + ",";
+    if(unit.neighbours.size()>0)
+      unit.props["NEIGHBOURS"].pop_back();
+  }
+}
+
 void FindNeighbouringDistricts(
   GeoCollection &gc,  
   const double max_neighbour_pt_dist,     ///< Distance within which a units are considered to be neighbours.
   const double max_boundary_pt_dist,      ///< Maximum distance between points on densified boundaries.
   const double expand_bb_by               ///< Distance by which units' bounding boxes are expanded. Only districts with overlapping boxes are checked for neighbourness. Value should be >0.
 ){
-  //Since a neighbour relationship is two-way, we can save time by making notes
-  //of those units for which we have already identified neighbours and avoiding
-  //repeating that work
-  std::unordered_set<unsigned int> found_neighbours;
-
   //Add all of the units to the R*-tree so we can quickly find neighbours.
   //Expand the bounding boxes of the units so that they will overlap if they are
   //neighbours
-  std::cerr<<"Creating R*-tree..."<<std::endl;
   SpIndex gcidx;
   for(unsigned int i=0;i<gc.size();i++)
     AddToSpIndex(gc.at(i), gcidx, i, expand_bb_by);
@@ -160,53 +210,57 @@ void FindNeighbouringDistricts(
 
   //The algorithm relies on boundary points having a certain maximum spacing.
   //Ensure that the boundaries meet this requirement.
-  std::cerr<<"Densifying borders..."<<std::endl;
   const auto densified_borders = GetDensifiedBorders(gc, max_boundary_pt_dist);
 
-  //Loop through all of the units
-  #pragma omp parallel for
-  for(unsigned int i=0;i<gc.size();i++){
-    auto &unit = gc.at(i);
-
-    // found_neighbours.insert(i); //TODO
-
-    //Find the neighbours of the unit by overlapping bounding boxes
-    const auto neighbours = gcidx.query(unit);
-
-    //Load the border of the central unit into a point cloud
-    std::cerr<<"Creating kd-tree..."<<std::endl;
-    typedef KDTreeVectorOfVectorsAdaptor< pointvec_t, double >  my_kd_tree_t;
-    my_kd_tree_t subidx(2 /*dim*/, densified_borders.second, 10 /* max leaf */ );
-    subidx.index->buildIndex();
-
-    std::cerr<<"Determining neighbourness..."<<std::endl;
-    //Loop over the neighbouring units
-    for(const auto &n: neighbours){
-      //We've already determined the neighbour relationships for unit `n`, so
-      //skip it.
-
-      //TODO
-      // if(found_neighbours.count(n)!=0)
-        // continue;
-
-      //Loop through all of the exterior points of the neighbour to see if any
-      //of the neighbours points are close to the focal unit's points. If so,
-      //the two are truly neighbours.
-      for(const auto &poly: gc.at(n))
+  //Find the neighbours of each unit by overlapping bounding boxes
+  const auto candidates = gcidx.queryBatch(gc);
+
+  //A single kd-tree of every unit's border points, shared by all the threads.
+  //Each point remembers which unit it came from.
+  typedef KDTreeVectorOfVectorsAdaptor< pointvec_t, double >  my_kd_tree_t;
+  const my_kd_tree_t border_idx(2 /*dim*/, densified_borders.second, 10 /* max leaf */ );
+
+  //Each unordered pair of units is tested only once. A pair is tested from the
+  //side with fewer exterior vertices: those vertices are looked up among the
+  //other unit's border points. Pairs found by each thread are collected in its
+  //own buffer and merged afterwards, so that no unit is written to by two
+  //threads at once.
+  const auto exterior_vertices = [&](const unsigned int u){
+    size_t count = 0;
+    const MultiPolygon &mp = gc.at(u);
+    for(const auto &poly: mp)
+      count += poly.at(0).size();
+    return count;
+  };
+
+  std::vector< std::pair<unsigned int, unsigned int> > adjacent;
+  #pragma omp parallel
+  {
+    std::vector< std::pair<unsigned int, unsigned int> > found;
+
+    #pragma omp for schedule(dynamic)
+    for(unsigned int i=0;i<gc.size();i++)
+    for(auto ni=candidates.begin(i);ni!=candidates.end(i);ni++){
+      const auto n = *ni;
+      if(n<=i)
+        continue;
+
+      //Loop through all of the exterior points of one unit to see if any of
+      //them are close to the other unit's border points. If so, the two are
+      //truly neighbours.
+      const bool from_i  = exterior_vertices(i)<exterior_vertices(n);
+      const auto querier = from_i ? i : n;
+      const auto owner   = from_i ? n : i;
+      const MultiPolygon &qmp = gc.at(querier);
+      for(const auto &poly: qmp)
       for(const auto &pt: poly.at(0)){
         const double qp[2] = {pt.x,pt.y};
 
-        //Find the nearest neighbour to the query point, irrespective of distance
-        const size_t num_results = 1; //Number of nearest neighbours to find
-        size_t nn_index;              //Index of the point that's been found
-        double nn_dist_sqr;           //Squared distance to the point
-        nanoflann::KNNResultSet<double> resultSet(num_results);
-        resultSet.init(&nn_index, &nn_dist_sqr);
-        subidx.index->findNeighbors(resultSet, &qp[0], nanoflann::SearchParams(10));
-
-        if(nn_dist_sqr<max_neighbour_pt_dist*max_neighbour_pt_dist){
-          unit.neighbours.push_back(n);
-          // gc.at(n).neighbours.push_back(i); //TODO
+        OwnerWithinRadius result_set(densified_borders.first, owner, max_neighbour_pt_dist*max_neighbour_pt_dist);
+        border_idx.index->findNeighbors(result_set, &qp[0], nanoflann::SearchParams(10));
+
+        if(result_set.found){
+          found.emplace_back(i,n);
           goto found_neighbour_exit_loops;
         }
       }
@@ -214,16 +268,193 @@ void FindNeighbouringDistricts(
       found_neighbour_exit_loops:
       (void)1;
     }
+
+    #pragma omp critical
+    adjacent.insert(adjacent.end(), found.begin(), found.end());
   }
 
-  for(auto &unit: gc){
-    unit.props["NEIGHNUM"]   = std::to_string(unit.neighbours.size());
-    unit.props["NEIGHBOURS"] = "";
-    for(const auto &n: unit.neighbours)
-      unit.props["NEIGHBOURS"] += std::to_string(n) + ",";
-    if(unit.neighbours.size()>0)
-      unit.props["NEIGHBOURS"].pop_back();
+  //Record each pair on both of its units, in a deterministic order
+  std::sort(adjacent.begin(), adjacent.end());
+  for(auto &unit: gc)
+    unit.neighbours.clear();
+  for(const auto &p: adjacent){
+    gc.at(p.first).neighbours.push_back(p.second);
+    gc.at(p.second).neighbours.push_back(p.first);
+  }
+
+  WriteNeighbourProps(gc);
+}
+
+
+
+//A quantised vertex or undirected edge, and the unit it came from
+class TopoRecord {
+ public:
+  int64_t      key[4];  //(x,y) of a vertex, or of both ends of an edge, smaller end first
+  uint64_t     hash;
+  unsigned int unit;
+  double       length;  //Length of an edge; zero for vertices
+};
+
+static int64_t QuantiseCoord(const double v, const double snap_to){
+  if(snap_to>0)
+    return std::llround(v/snap_to);
+  if(v==0)
+    return 0; //0.0 and -0.0 are the same place
+  int64_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+static uint64_t HashKey(const int64_t key[4]){
+  uint64_t h = 0;
+  for(int i=0;i<4;i++){
+    //splitmix64 finaliser
+    uint64_t z = h + (uint64_t)key[i] + 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z>>30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z>>27)) * 0x94d049bb133111ebull;
+    h = z ^ (z>>31);
   }
+  return h;
+}
+
+//Find all the pairs of distinct units which have records with the same key.
+//Records are spread into buckets by hash in linear time; each bucket is then
+//small enough that sorting it is cheap, and the buckets are handled in
+//parallel.
+static std::vector<Adjacency> MatchRecords(const std::vector<TopoRecord> &recs){
+  const int    bucket_bits = 12;
+  const size_t nbuckets    = (size_t)1<<bucket_bits;
+  const auto bucket_of = [&](const TopoRecord &r){ return (size_t)(r.hash>>(64-bucket_bits)); };
+
+  std::vector<size_t> offsets(nbuckets+1, 0);
+  for(const auto &r: recs)
+    offsets[bucket_of(r)+1]++;
+  for(size_t b=1;b<offsets.size();b++)
+    offsets[b] += offsets[b-1];
+  std::vector<TopoRecord> bucketed(recs.size());
+  {
+    std::vector<size_t> fill(offsets.begin(), offsets.end()-1);
+    for(const auto &r: recs)
+      bucketed[fill[bucket_of(r)]++] = r;
+  }
+
+  std::vector< std::vector<Adjacency> > found(nbuckets);
+  #pragma omp parallel for schedule(dynamic,16)
+  for(unsigned int b=0;b<nbuckets;b++){
+    const auto first = bucketed.begin()+offsets[b];
+    const auto last  = bucketed.begin()+offsets[b+1];
+    const auto same_key = [](const TopoRecord &x, const TopoRecord &y){
+      return x.hash==y.hash && std::equal(x.key, x.key+4, y.key);
+    };
+    std::sort(first, last, [](const TopoRecord &x, const TopoRecord &y){
+      if(x.hash!=y.hash)
+        return x.hash<y.hash;
+      if(!std::equal(x.key, x.key+4, y.key))
+        return std::lexicographical_compare(x.key, x.key+4, y.key, y.key+4);
+      return x.unit<y.unit;
+    });
+    //Every pair of different units in a run of equal keys are neighbours
+    for(auto run=first;run!=last;){
+      auto run_end = run+1;
+      while(run_end!=last && same_key(*run,*run_end))
+        run_end++;
+      for(auto x=run;x!=run_end;x++)
+      for(auto y=x+1;y!=run_end;y++)
+        if(x->unit!=y->unit)
+          found[b].push_back(Adjacency{x->unit, y->unit, x->length});
+      run = run_end;
+    }
+  }
+
+  //Gather the pairs and combine the lengths of pairs which share several edges
+  std::vector<Adjacency> all;
+  for(const auto &f: found)
+    all.insert(all.end(), f.begin(), f.end());
+  std::sort(all.begin(), all.end(), [](const Adjacency &x, const Adjacency &y){
+    return x.a<y.a || (x.a==y.a && x.b<y.b);
+  });
+  std::vector<Adjacency> ret;
+  for(const auto &adj: all){
+    if(!ret.empty() && ret.back().a==adj.a && ret.back().b==adj.b)
+      ret.back().shared_length += adj.shared_length;
+    else
+      ret.push_back(adj);
+  }
+  return ret;
+}
+
+std::vector<Adjacency> FindTopologicalNeighbours(
+  GeoCollection &gc,
+  const Contiguity contiguity,
+  const double snap_to
+){
+  const bool queen = contiguity==Contiguity::Queen;
+
+  //Every vertex starts one edge, so both kinds of record can be laid out the
+  //same way: each unit gets a contiguous slice, filled in parallel
+  std::vector<size_t> offsets(gc.size()+1, 0);
+  for(unsigned int u=0;u<gc.size();u++)
+    offsets[u+1] = offsets[u] + gc.at(u).summary().vertex_count;
+
+  std::vector<TopoRecord> recs(offsets.back()*(queen ? 2 : 1));
+  const size_t vertex_base = offsets.back();
+
+  #pragma omp parallel for schedule(dynamic)
+  for(unsigned int u=0;u<gc.size();u++){
+    size_t ri = offsets[u];
+    const MultiPolygon &mp = gc.at(u);
+    for(const auto &poly: mp)
+    for(const auto &ring: poly)
+    for(unsigned int i=0;i<ring.size();i++){
+      const auto &pa = ring[i];
+      const auto &pb = ring[(i+1)%ring.size()];
+      const int64_t a[2] = {QuantiseCoord(pa.x,snap_to), QuantiseCoord(pa.y,snap_to)};
+      const int64_t b[2] = {QuantiseCoord(pb.x,snap_to), QuantiseCoord(pb.y,snap_to)};
+
+      auto &e = recs[ri];
+      const bool a_first = std::lexicographical_compare(a, a+2, b, b+2);
+      e.key[0] = a_first ? a[0] : b[0];
+      e.key[1] = a_first ? a[1] : b[1];
+      e.key[2] = a_first ? b[0] : a[0];
+      e.key[3] = a_first ? b[1] : a[1];
+      e.hash   = HashKey(e.key);
+      e.length = EuclideanDistance(pa,pb);
+      //Degenerate edges (such as the one from a closed ring's last point back
+      //to its first) join nothing; they get a key no real edge can have
+      e.unit   = u;
+      if(a[0]==b[0] && a[1]==b[1]){
+        e.key[0] = e.key[2] = (int64_t)u;
+        e.key[1] = e.key[3] = 0;
+        e.hash   = HashKey(e.key);
+      }
+
+      if(queen){
+        auto &v = recs[vertex_base+ri];
+        v.key[0] = a[0];
+        v.key[1] = a[1];
+        v.key[2] = v.key[3] = 0;
+        v.hash   = HashKey(v.key) ^ 1; //Keep vertices from matching edges
+        v.unit   = u;
+        v.length = 0;
+      }
+      ri++;
+    }
+  }
+
+  auto adjacencies = MatchRecords(recs);
+
+  for(auto &unit: gc)
+    unit.neighbours.clear();
+  for(const auto &adj: adjacencies){
+    gc.at(adj.a).neighbours.push_back(adj.b);
+    gc.at(adj.b).neighbours.push_back(adj.a);
+  }
+  for(auto &unit: gc)
+    std::sort(unit.neighbours.begin(), unit.neighbours.end());
+  WriteNeighbourProps(gc);
+
+  return adjacencies;
 }
 
 
@@ -236,24 +467,47 @@ void CalcParentOverlap(
   const double max_boundary_pt_dist,      ///< Maximum distance between points on densified boundaries.
   const double edge_adjacency_dist        ///< Distance within which a subunit is considered to be on the border of a superunit.
 ){
-  SpIndex supidx;
-
-  //Add all the superunits to an R*-tree so we can quickly find potential
-  //children using minimum bounding boxes.
-  for(unsigned int i=0;i<superunits.size();i++)
-    AddToSpIndex(superunits.at(i), supidx, i, 0.);
-  supidx.buildIndex();
+  //Find all the (subunit, superunit) pairs whose bounding boxes overlap. These
+  //are the potential parents of each subunit. The pairs are sorted by subunit.
+  const auto candidates = SpatialJoin(subunits, superunits);
+
+  //Index each superunit's edges once. Most subunits then turn out to be wholly
+  //inside or wholly outside a candidate parent, and only those straddling its
+  //border need to be clipped.
+  std::vector<PreparedPolygon> prepared(superunits.size());
+  #pragma omp parallel for schedule(dynamic)
+  for(unsigned int p=0;p<superunits.size();p++)
+    prepared[p] = PreparedPolygon(superunits.at(p));
 
   #pragma omp parallel for
   for(unsigned int i=0;i<subunits.size();i++){
     auto &sub = subunits.at(i);
 
-    const auto parents = supidx.query(sub);
     const double area  = areaExcludingHoles(sub);
 
+    const auto parents = std::equal_range(
+      candidates.begin(), candidates.end(), std::make_pair(i,0u),
+      [](const std::pair<unsigned int, unsigned int> &a, const std::pair<unsigned int, unsigned int> &b){
+        return a.first<b.first;
+      }
+    );
+
+    //A subunit straddling a parent's border is prepared the first time it is
+    //needed, and reused for any other parents whose borders it straddles
+    PreparedPolygon sub_prepared;
+    bool            sub_is_prepared = false;
+
     //Loop over the parent units
-    for(auto &p: parents){
-      const double iarea = IntersectionArea(sub, superunits.at(p));
+    for(auto pi=parents.first;pi!=parents.second;pi++){
+      const auto p = pi->second;
+      double iarea;
+      if(!TryIntersectionArea(sub, prepared[p], iarea)){
+        if(!sub_is_prepared){
+          sub_prepared    = PreparedPolygon(sub);
+          sub_is_prepared = true;
+        }
+        iarea = IntersectionArea(sub_prepared, prepared[p]);
+      }
       const double frac  = iarea/area;
       if(frac>complete_inclusion_thresh){
         sub.parents.clear();
@@ -288,17 +542,20 @@ void CalcParentOverlap(
   //the points which belong to the borders of the superunits
   typedef KDTreeVectorOfVectorsAdaptor< pointvec_t, double >  my_kd_tree_t;
   my_kd_tree_t border_idx(2 /*dim*/, sup_densified_borders.second, 10 /* max leaf */ );
-  std::cerr<<"Constructing kd-tree..."<<std::endl;
   border_idx.index->buildIndex();
-  std::cerr<<"done."<<std::endl;
 
-  #pragma omp parallel for default(none) shared(subunits, border_idx)
+  //Each subunit's densified points form one contiguous run, so each subunit
+  //looks up only its own points
+  const auto sub_offsets = OwnerOffsets(sub_densified_borders.first, subunits.size());
+
+  #pragma omp parallel for schedule(dynamic)
   for(unsigned int subi=0;subi<subunits.size();subi++){
     //Alias the current subunit
     auto &sub = subunits[subi];
 
     //Loop through all of the points in the subunit
-    for(const auto &pt: sub_densified_borders.second){
+    for(size_t pti=sub_offsets[subi];pti<sub_offsets[subi+1];pti++){
+      const auto &pt = sub_densified_borders.second[pti];
       //Find the nearest neighbour to the query point, irrespective of distance
       const size_t num_results = 1; //Number of nearest neighbours to find
       size_t nn_index;              //Index of the point that's been found
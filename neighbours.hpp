@@ -2,6 +2,7 @@
 #define _neighbours_hpp_
 
 #include "geom.hpp"
+#include <vector>
 
 namespace complib {
   void FindNeighbouringDistricts(
@@ -11,6 +12,36 @@ namespace complib {
     const double expand_bb_by               ///< Distance by which units' bounding boxes are expanded. Only districts with overlapping boxes are checked for neighbourness. Value should be >0.
   );
 
+  enum class Contiguity {
+    Rook,  ///< Units are neighbours if they share an edge
+    Queen  ///< Units are neighbours if they share an edge or just a vertex
+  };
+
+  ///A pair of neighbouring units and the length of boundary they share
+  class Adjacency {
+   public:
+    unsigned int a;             ///< Index of the first unit; always less than b
+    unsigned int b;             ///< Index of the second unit
+    double       shared_length; ///< Total length of the edges the two units share. Zero for units which meet only at vertices.
+  };
+
+  ///Find neighbours exactly from the units' topology, rather than by distance:
+  ///units are neighbours if they have edges (rook) or vertices (queen) in
+  ///common. This suits data such as TIGER/Line, where neighbouring units have
+  ///exactly coincident vertices along their shared borders. Coordinates are
+  ///snapped to a grid of spacing `snap_to` before being compared; with the
+  ///default of zero they must match exactly. Runs in time roughly linear in the
+  ///total number of vertices. Fills in each unit's `neighbours` and the
+  ///NEIGHNUM and NEIGHBOURS properties, and returns the pairs sorted.
+  std::vector<Adjacency> FindTopologicalNeighbours(
+    GeoCollection &gc,
+    const Contiguity contiguity,
+    const double snap_to = 0
+  );
+
+  ///Find each subunit's parents, the superunits it overlaps. Either collection
+  ///may contain overlapping units. When both are partitions, PartitionOverlay()
+  ///finds all the overlap areas in a single pass.
   void CalcParentOverlap(
     GeoCollection &subunits,
     GeoCollection &superunits,
@@ -0,0 +1,285 @@
+#include "overlay.hpp"
+#include "geocode.hpp"
+#include "hilbert_rtree.hpp"
+#include "prepared_polygon.hpp"
+#include "SpIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+namespace complib {
+
+typedef PointInPolygonIndex::Edge Edge;
+
+//Exact coordinates of an undirected edge, smaller end first
+class EdgeKey {
+ public:
+  double v[4];
+  bool operator==(const EdgeKey &o) const {
+    return std::memcmp(v, o.v, sizeof(v))==0;
+  }
+};
+
+class EdgeKeyHash {
+ public:
+  size_t operator()(const EdgeKey &k) const {
+    uint64_t h = 1469598103934665603ULL;
+    for(const auto &x: k.v){
+      uint64_t bits;
+      std::memcpy(&bits, &x, sizeof(bits));
+      h = (h^bits)*1099511628211ULL;
+      h ^= h>>29;
+    }
+    return h;
+  }
+};
+
+static EdgeKey MakeEdgeKey(const Point2D &a, const Point2D &b){
+  //Adding zero turns -0 into +0, so the two compare equal bitwise
+  const bool a_first = a.x<b.x || (a.x==b.x && a.y<b.y);
+  const auto &p = a_first ? a : b;
+  const auto &q = a_first ? b : a;
+  return EdgeKey{{p.x+0.0, p.y+0.0, q.x+0.0, q.y+0.0}};
+}
+
+static BoundingBox EdgeBox(const Edge &e){
+  return BoundingBox(std::min(e.a.x,e.b.x), std::min(e.a.y,e.b.y), std::max(e.a.x,e.b.x), std::max(e.a.y,e.b.y));
+}
+
+static Point2D PointAlong(const Edge &e, const double t){
+  if(t==0)
+    return e.a;
+  if(t==1)
+    return e.b;
+  return Point2D(e.a.x+t*(e.b.x-e.a.x), e.a.y+t*(e.b.y-e.a.y));
+}
+
+
+
+//The edges of a partition, each border listed once however many units it
+//bounds, along with a way to find the unit containing a point
+class PartitionEdges {
+ public:
+  std::vector<Edge>                         edges;
+  std::vector<unsigned int>                 left;  ///< Unit on each edge's left (the interior side), or NO_FEATURE
+  std::vector<unsigned int>                 right; ///< Unit on its right, or NO_FEATURE
+  std::shared_ptr<const PackedHilbertRTree> idx;
+
+  explicit PartitionEdges(const GeoCollection &gc){
+    std::unordered_map<EdgeKey, unsigned int, EdgeKeyHash> seen;
+    for(unsigned int u=0;u<gc.size();u++)
+    for(const auto &poly: gc[u])
+    for(unsigned int ri=0;ri<poly.size();ri++){
+      const auto &ring = poly.at(ri);
+      //Outer rings run counter-clockwise and holes clockwise, so that the
+      //unit is always on an edge's left
+      const bool flip = (ri==0) != (ring.summary().signed_area>0);
+      for(unsigned int i=0;i<ring.size();i++){
+        auto a = ring.at(i);
+        auto b = ring.at((i+1)%ring.size()); //Loop around to beginning
+        if(a.x==b.x && a.y==b.y)
+          continue;
+        if(flip)
+          std::swap(a,b);
+
+        //A neighbour which has already listed this edge, running the other way,
+        //is the unit on its right
+        const auto key = MakeEdgeKey(a,b);
+        const auto found = seen.find(key);
+        if(found!=seen.end()){
+          const auto k = found->second;
+          if(right[k]==NO_FEATURE && left[k]!=u && edges[k].a.x==b.x && edges[k].a.y==b.y){
+            right[k] = u;
+            continue;
+          }
+        }
+        seen[key] = edges.size();
+        edges.push_back(Edge{a,b});
+        left.push_back(u);
+        right.push_back(NO_FEATURE);
+      }
+    }
+
+    idbb boxes;
+    boxes.reserve(edges.size());
+    for(unsigned int e=0;e<edges.size();e++)
+      boxes.emplace_back(e, EdgeBox(edges[e]));
+    idx = std::make_shared<PackedHilbertRTree>(boxes);
+
+    for(unsigned int u=0;u<gc.size();u++)
+      AddToSpIndex(gc[u], units, u, 0);
+    units.buildIndex();
+
+    pips.resize(gc.size());
+    #pragma omp parallel for schedule(dynamic)
+    for(unsigned int u=0;u<gc.size();u++)
+      pips[u] = PointInPolygonIndex(gc[u]);
+  }
+
+  //The unit containing `p`, or NO_FEATURE
+  unsigned int locate(const Point2D &p) const {
+    unsigned int owner = NO_FEATURE;
+    units.query(BoundingBox(p.x,p.y,p.x,p.y), [&](const unsigned int u){
+      if(u<owner && pips[u].contains(p))
+        owner = u;
+    });
+    return owner;
+  }
+
+ private:
+  SpIndex                          units;
+  std::vector<PointInPolygonIndex> pips;
+};
+
+
+
+std::vector<AreaOverlap> PartitionOverlay(const GeoCollection &subunits, const GeoCollection &superunits){
+  if(subunits.size()==0 || superunits.size()==0)
+    return {};
+
+  const PartitionEdges sub_edges(subunits);
+  const PartitionEdges sup_edges(superunits);
+  const size_t nsub_edges = sub_edges.edges.size();
+  const size_t nedges     = nsub_edges+sup_edges.edges.size();
+  if(nedges==0)
+    return {};
+
+  const auto edge = [&](const size_t i) -> const Edge& {
+    return i<nsub_edges ? sub_edges.edges[i] : sup_edges.edges[i-nsub_edges];
+  };
+
+  //Measuring from a nearby origin keeps the products small, and so precise
+  Point2D origin(std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity());
+  double xmax = -std::numeric_limits<double>::infinity();
+  for(size_t i=0;i<nedges;i++){
+    const auto &e = edge(i);
+    origin.x = std::min(origin.x, std::min(e.a.x,e.b.x));
+    origin.y = std::min(origin.y, std::min(e.a.y,e.b.y));
+    xmax     = std::max(xmax,     std::max(e.a.x,e.b.x));
+  }
+
+  //Group the edges of both partitions into vertical strips by their midpoints,
+  //so that each thread works on one neighbourhood at a time
+  #ifdef _OPENMP
+    const size_t nstrips = 8*omp_get_max_threads();
+  #else
+    const size_t nstrips = 1;
+  #endif
+  const double strip_width = (xmax-origin.x)/nstrips;
+  const auto strip_of = [&](const Edge &e){
+    const double s = std::floor(((e.a.x+e.b.x)/2-origin.x)/strip_width);
+    return (s>=0 && strip_width>0) ? std::min(nstrips-1, (size_t)s) : (size_t)0;
+  };
+  std::vector<size_t> strip_offsets(nstrips+1, 0);
+  for(size_t i=0;i<nedges;i++)
+    strip_offsets[strip_of(edge(i))+1]++;
+  for(size_t s=1;s<strip_offsets.size();s++)
+    strip_offsets[s] += strip_offsets[s-1];
+  std::vector<size_t> strip_edges(nedges);
+  {
+    std::vector<size_t> fill(strip_offsets.begin(), strip_offsets.end()-1);
+    for(size_t i=0;i<nedges;i++)
+      strip_edges[fill[strip_of(edge(i))]++] = i;
+  }
+
+  //Twice the area of each (subunit, superunit) intersection, keyed by the pair
+  std::unordered_map<uint64_t, double> twice_areas;
+
+  #pragma omp parallel
+  {
+    std::unordered_map<uint64_t, double> local;
+    std::vector<double>        cuts;
+    std::vector<SharedStretch> shared;
+
+    const auto add = [&](const unsigned int sub, const unsigned int sup, const double twice_area){
+      if(sub!=NO_FEATURE && sup!=NO_FEATURE)
+        local[((uint64_t)sub<<32) | sup] += twice_area;
+    };
+
+    #pragma omp for schedule(dynamic)
+    for(long s=0;s<(long)nstrips;s++)
+    for(size_t k=strip_offsets[s];k<strip_offsets[s+1];k++){
+      const size_t i        = strip_edges[k];
+      const bool   from_sub = i<nsub_edges;
+      const auto  &mine     = from_sub ? sub_edges : sup_edges;
+      const auto  &other    = from_sub ? sup_edges : sub_edges;
+      const size_t ei       = from_sub ? i : i-nsub_edges;
+      const auto  &e        = mine.edges[ei];
+
+      cuts.assign({0.0, 1.0});
+      shared.clear();
+      SplitEdge(e.a, e.b, other.edges, *other.idx, cuts, shared);
+      std::sort(cuts.begin(), cuts.end());
+
+      for(unsigned int c=1;c<cuts.size();c++){
+        const double t0 = cuts[c-1];
+        const double t1 = cuts[c];
+        if(!(t1-t0>1e-12))
+          continue;
+        const double mid = (t0+t1)/2;
+
+        //Find the other partition's units on either side of this piece. A
+        //piece running along one of the other partition's edges takes them
+        //from that edge; such pieces are counted from the subunits' side only.
+        unsigned int other_left  = NO_FEATURE;
+        unsigned int other_right = NO_FEATURE;
+        bool on_shared = false;
+        for(const auto &sh: shared){
+          if(!(sh.lo<=mid && mid<=sh.hi))
+            continue;
+          on_shared = true;
+          auto l = other.left[sh.edge];
+          auto r = other.right[sh.edge];
+          if(!sh.same_direction)
+            std::swap(l,r);
+          if(other_left==NO_FEATURE)
+            other_left = l;
+          if(other_right==NO_FEATURE)
+            other_right = r;
+        }
+        if(on_shared && !from_sub)
+          continue;
+        if(!on_shared)
+          other_left = other_right = other.locate(PointAlong(e, mid));
+
+        const auto p = PointAlong(e, t0);
+        const auto q = PointAlong(e, t1);
+        const double twice_area = (p.x-origin.x)*(q.y-origin.y)-(q.x-origin.x)*(p.y-origin.y);
+
+        //The piece bounds the intersection of the units on its left, running
+        //forwards, and of the units on its right, running backwards
+        const auto my_left  = mine.left[ei];
+        const auto my_right = mine.right[ei];
+        if(from_sub){
+          add(my_left,  other_left,   twice_area);
+          add(my_right, other_right, -twice_area);
+        } else {
+          add(other_left,  my_left,   twice_area);
+          add(other_right, my_right, -twice_area);
+        }
+      }
+    }
+
+    #pragma omp critical
+    for(const auto &kv: local)
+      twice_areas[kv.first] += kv.second;
+  }
+
+  std::vector<AreaOverlap> ret;
+  for(const auto &kv: twice_areas)
+    if(kv.second>0)
+      ret.push_back(AreaOverlap{(unsigned int)(kv.first>>32), (unsigned int)(kv.first&0xFFFFFFFF), kv.second/2});
+  std::sort(ret.begin(), ret.end(), [](const AreaOverlap &a, const AreaOverlap &b){
+    return a.sub<b.sub || (a.sub==b.sub && a.sup<b.sup);
+  });
+  return ret;
+}
+
+}
@@ -0,0 +1,32 @@
+#ifndef _overlay_hpp_
+#define _overlay_hpp_
+
+#include "geom.hpp"
+#include <vector>
+
+namespace complib {
+
+///Area shared by a subunit and a superunit
+class AreaOverlap {
+ public:
+  unsigned int sub;  ///< Index of the subunit
+  unsigned int sup;  ///< Index of the superunit
+  double       area; ///< Area of their intersection
+};
+
+///Overlay two partitions, such as all of a state's precincts and all of its
+///districts, and find the area shared by every subunit and superunit which
+///overlap. Returns a sparse matrix of the overlapping pairs, sorted by subunit
+///and then superunit.
+///
+///Each collection must be a partition: its units may share borders but must
+///not overlap. Gaps (water, unassigned land) are fine. The area is integrated
+///over the boundaries of all the pairwise intersections in a single pass over
+///both partitions' edges. Each border shared by two units of a partition is
+///visited once, for both of them. The edges are worked on in parallel, in
+///vertical strips.
+std::vector<AreaOverlap> PartitionOverlay(const GeoCollection &subunits, const GeoCollection &superunits);
+
+}
+
+#endif
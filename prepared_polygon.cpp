@@ -0,0 +1,437 @@
+#include "prepared_polygon.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace complib {
+
+static BoundingBox EdgeBox(const Point2D &a, const Point2D &b){
+  return BoundingBox(std::min(a.x,b.x), std::min(a.y,b.y), std::max(a.x,b.x), std::max(a.y,b.y));
+}
+
+static bool BoxesOverlap(const BoundingBox &a, const BoundingBox &b){
+  return !(a.min[0]>b.max[0] || b.min[0]>a.max[0] || a.min[1]>b.max[1] || b.min[1]>a.max[1]);
+}
+
+//Twice the signed area of the triangle abc: positive if c is left of a->b
+static double Orient(const Point2D &a, const Point2D &b, const Point2D &c){
+  return (b.x-a.x)*(c.y-a.y)-(b.y-a.y)*(c.x-a.x);
+}
+
+//Whether p, known to be collinear with a and b, lies between them
+static bool WithinSegment(const Point2D &a, const Point2D &b, const Point2D &p){
+  return std::min(a.x,b.x)<=p.x && p.x<=std::max(a.x,b.x) && std::min(a.y,b.y)<=p.y && p.y<=std::max(a.y,b.y);
+}
+
+//Whether the closed segments p1p2 and q1q2 have any point in common
+static bool SegmentsTouch(const Point2D &p1, const Point2D &p2, const Point2D &q1, const Point2D &q2){
+  const double d1 = Orient(q1,q2,p1);
+  const double d2 = Orient(q1,q2,p2);
+  const double d3 = Orient(p1,p2,q1);
+  const double d4 = Orient(p1,p2,q2);
+  if( ((d1>0 && d2<0) || (d1<0 && d2>0)) && ((d3>0 && d4<0) || (d3<0 && d4>0)) )
+    return true;
+  return (d1==0 && WithinSegment(q1,q2,p1))
+      || (d2==0 && WithinSegment(q1,q2,p2))
+      || (d3==0 && WithinSegment(p1,p2,q1))
+      || (d4==0 && WithinSegment(p1,p2,q2));
+}
+
+//Squared distance from p to the closest point of the segment ab
+static double SegmentDistanceSq(const Point2D &p, const Point2D &a, const Point2D &b){
+  const double dx  = b.x-a.x;
+  const double dy  = b.y-a.y;
+  const double len = dx*dx+dy*dy;
+  double t = len>0 ? ((p.x-a.x)*dx+(p.y-a.y)*dy)/len : 0;
+  t = std::max(0.0, std::min(1.0, t));
+  const double ex = a.x+t*dx-p.x;
+  const double ey = a.y+t*dy-p.y;
+  return ex*ex+ey*ey;
+}
+
+//The point a fraction t of the way along an edge. The ends are exact.
+static Point2D PointAlong(const PointInPolygonIndex::Edge &e, const double t){
+  if(t==0)
+    return e.a;
+  if(t==1)
+    return e.b;
+  return Point2D(e.a.x+t*(e.b.x-e.a.x), e.a.y+t*(e.b.y-e.a.y));
+}
+
+//Whether the edge a->b crosses the ray running from p in the +x direction
+static bool CrossesRay(const Point2D &a, const Point2D &b, const Point2D &p){
+  return ((a.y>p.y) != (b.y>p.y)) && (p.x < (b.x-a.x)*(p.y-a.y)/(b.y-a.y)+a.x);
+}
+
+//Even-odd point-in-polygon test against all of a polygon's n rings
+static bool PolygonContainsPoint(const Ring *const prings, const size_t n, const Point2D &p){
+  bool inside = false;
+  for(size_t r=0;r<n;r++){
+    const auto &ring = prings[r];
+    for(unsigned int i=0,j=ring.size()-1;i<ring.size();j=i++)
+      if(CrossesRay(ring[j], ring[i], p))
+        inside = !inside;
+  }
+  return inside;
+}
+
+
+
+PointInPolygonIndex::PointInPolygonIndex(const MultiPolygon &mp){
+  //Horizontal edges never cross a ray along +x, so they are left out
+  std::vector<Edge> edges;
+  for(const auto &poly: mp)
+  for(const auto &ring: poly)
+  for(unsigned int i=0;i<ring.size();i++){
+    const auto &a = ring.at(i);
+    const auto &b = ring.at((i+1)%ring.size()); //Loop around to beginning
+    if(a.y!=b.y)
+      edges.push_back(Edge{a,b});
+  }
+  if(edges.empty())
+    return;
+
+  y0 = std::numeric_limits<double>::infinity();
+  y1 = -std::numeric_limits<double>::infinity();
+  for(const auto &e: edges){
+    y0 = std::min(y0, std::min(e.a.y,e.b.y));
+    y1 = std::max(y1, std::max(e.a.y,e.b.y));
+  }
+
+  //Aim for a handful of edges per slab, but use fewer slabs if long edges
+  //would be listed in too many of them
+  nslabs = edges.size()/4+1;
+  while(true){
+    inv_height = nslabs/(y1-y0);
+    size_t entries = 0;
+    for(const auto &e: edges)
+      entries += slabOf(std::max(e.a.y,e.b.y))-slabOf(std::min(e.a.y,e.b.y))+1;
+    if(nslabs==1 || entries<=8*edges.size())
+      break;
+    nslabs /= 2;
+  }
+
+  //Count the edges in each slab, turn the counts into offsets, then fill in
+  slab_offsets.assign(nslabs+1, 0);
+  for(const auto &e: edges)
+  for(size_t s=slabOf(std::min(e.a.y,e.b.y));s<=slabOf(std::max(e.a.y,e.b.y));s++)
+    slab_offsets[s+1]++;
+  for(size_t s=1;s<slab_offsets.size();s++)
+    slab_offsets[s] += slab_offsets[s-1];
+  slab_edges.resize(slab_offsets.back());
+  std::vector<size_t> fill(slab_offsets.begin(), slab_offsets.end()-1);
+  for(const auto &e: edges)
+  for(size_t s=slabOf(std::min(e.a.y,e.b.y));s<=slabOf(std::max(e.a.y,e.b.y));s++)
+    slab_edges[fill[s]++] = e;
+}
+
+size_t PointInPolygonIndex::slabOf(const double y) const {
+  const double s = std::floor((y-y0)*inv_height);
+  return s<0 ? 0 : std::min(nslabs-1, (size_t)s);
+}
+
+bool PointInPolygonIndex::contains(const Point2D &p) const {
+  if(slab_edges.empty() || p.y<y0 || p.y>y1)
+    return false;
+  const size_t s = slabOf(p.y);
+  bool inside = false;
+  for(size_t e=slab_offsets[s];e<slab_offsets[s+1];e++)
+    if(CrossesRay(slab_edges[e].a, slab_edges[e].b, p))
+      inside = !inside;
+  return inside;
+}
+
+
+
+PreparedPolygon::PreparedPolygon(const MultiPolygon &mp){
+  idbb edge_boxes;
+  for(const auto &poly: mp)
+  for(unsigned int ri=0;ri<poly.size();ri++){
+    const auto &ring = poly.at(ri);
+    if(ring.size()==0)
+      continue;
+    rings.push_back(RingInfo{ring.summary().bbox, ring.at(0)});
+    //Outer rings run counter-clockwise and holes clockwise, so that the
+    //interior is always on an edge's left
+    const bool flip = (ri==0) != (ring.summary().signed_area>0);
+    for(unsigned int i=0;i<ring.size();i++){
+      const auto &a = ring.at(i);
+      const auto &b = ring.at((i+1)%ring.size()); //Loop around to beginning
+      if(a.x==b.x && a.y==b.y)
+        continue;
+      edge_boxes.emplace_back(edges.size(), EdgeBox(a,b));
+      edges.push_back(flip ? Edge{b,a} : Edge{a,b});
+    }
+  }
+  box      = mp.bbox();
+  edge_idx = std::make_shared<PackedHilbertRTree>(edge_boxes);
+  geom     = std::make_shared<MultiPolygon>(mp);
+  pip      = PointInPolygonIndex(mp);
+}
+
+static MultiPolygon RingToMultiPolygon(const Ring &ring){
+  MultiPolygon mp;
+  mp.v.emplace_back();
+  mp.v.back().v.push_back(ring);
+  return mp;
+}
+
+PreparedPolygon::PreparedPolygon(const Ring &ring) : PreparedPolygon(RingToMultiPolygon(ring)) {}
+
+BoundingBox PreparedPolygon::bbox() const {
+  return box;
+}
+
+const MultiPolygon& PreparedPolygon::geometry() const {
+  static const MultiPolygon empty;
+  return geom ? *geom : empty;
+}
+
+const ClipperLib::Paths& PreparedPolygon::clipperPaths() const {
+  return clipper_cache.get([&](){
+    const auto &mp = geometry();
+    return mp.clipper_paths.empty() ? ConvertToClipper(mp, false) : mp.clipper_paths;
+  });
+}
+
+bool PreparedPolygon::containsPoint(const Point2D &p) const {
+  if(p.x<box.xmin() || p.x>box.xmax())
+    return false;
+  return pip.contains(p);
+}
+
+PreparedPolygon::Overlap PreparedPolygon::classify(const Polygon &poly) const {
+  if(poly.size()==0 || poly.at(0).size()==0)
+    return Overlap::Outside;
+  return classifyRings(poly.v.data(), poly.size(), poly.summary().bbox);
+}
+
+PreparedPolygon::Overlap PreparedPolygon::classify(const Ring &ring) const {
+  if(ring.size()==0)
+    return Overlap::Outside;
+  return classifyRings(&ring, 1, ring.summary().bbox);
+}
+
+//The first of the n rings is the polygon's outer ring, the rest its holes
+PreparedPolygon::Overlap PreparedPolygon::classifyRings(const Ring *const prings, const size_t n, const BoundingBox &pbox) const {
+  if(!edge_idx || !BoxesOverlap(pbox, box))
+    return Overlap::Outside;
+
+  //If any edge of the polygon meets one of ours, the boundaries interact
+  for(size_t pr=0;pr<n;pr++){
+    const auto &ring = prings[pr];
+    for(unsigned int i=0;i<ring.size();i++){
+      const auto &a = ring.at(i);
+      const auto &b = ring.at((i+1)%ring.size());
+      bool touches = false;
+      edge_idx->query(EdgeBox(a,b), [&](const unsigned int e){
+        touches = touches || SegmentsTouch(a, b, edges[e].a, edges[e].b);
+      });
+      if(touches)
+        return Overlap::Boundary;
+    }
+  }
+
+  //The boundaries are disjoint, but one of our rings may lie wholly within the
+  //polygon (an island, or a hole punched in the middle of it)
+  for(const auto &r: rings)
+    if(BoxesOverlap(r.bbox, pbox) && PolygonContainsPoint(prings, n, r.vertex))
+      return Overlap::Boundary;
+
+  //Otherwise the polygon is wholly on one side of our boundary, and any one of
+  //its vertices tells which
+  return containsPoint(prings[0][0]) ? Overlap::Inside : Overlap::Outside;
+}
+
+PreparedPolygon::Overlap PreparedPolygon::classify(const Circle &c) const {
+  const BoundingBox cbox(c.center.x-c.radius, c.center.y-c.radius, c.center.x+c.radius, c.center.y+c.radius);
+  if(!edge_idx || !BoxesOverlap(cbox, box))
+    return Overlap::Outside;
+
+  //Any of our rings entering the disk, or lying wholly within it, has an edge
+  //within a radius of the centre
+  const double r2 = c.radius*c.radius;
+  bool near = false;
+  edge_idx->query(cbox, [&](const unsigned int e){
+    near = near || SegmentDistanceSq(c.center, edges[e].a, edges[e].b)<=r2;
+  });
+  if(near)
+    return Overlap::Boundary;
+
+  return containsPoint(c.center) ? Overlap::Inside : Overlap::Outside;
+}
+
+
+
+bool TryIntersectionArea(const MultiPolygon &sub, const PreparedPolygon &prepared, double &area){
+  double total = 0;
+  for(const auto &poly: sub){
+    switch(prepared.classify(poly)){
+      case PreparedPolygon::Overlap::Boundary:
+        return false;
+      case PreparedPolygon::Overlap::Inside:
+        total += poly.summary().area-poly.summary().hole_area;
+        break;
+      case PreparedPolygon::Overlap::Outside:
+        break;
+    }
+  }
+  area = total;
+  return true;
+}
+
+
+
+void SplitEdge(
+  const Point2D &a,
+  const Point2D &b,
+  const std::vector<PointInPolygonIndex::Edge> &others,
+  const PackedHilbertRTree &idx,
+  std::vector<double> &cuts,
+  std::vector<SharedStretch> &shared
+){
+  const double dx   = b.x-a.x;
+  const double dy   = b.y-a.y;
+  const double len2 = dx*dx+dy*dy;
+  if(!(len2>0))
+    return;
+  const auto param = [&](const Point2D &p){
+    return ((p.x-a.x)*dx+(p.y-a.y)*dy)/len2;
+  };
+
+  idx.query(EdgeBox(a,b), [&](const unsigned int fi){
+    const auto &f = others[fi];
+    //Orient() is the edge's length times the distance from its line, so this
+    //treats points within a tiny fraction of the edges' lengths of the line as
+    //being on it
+    const double flen = std::sqrt((f.b.x-f.a.x)*(f.b.x-f.a.x)+(f.b.y-f.a.y)*(f.b.y-f.a.y));
+    const double tol  = 1e-10*std::sqrt(len2)*(std::sqrt(len2)+flen);
+    const double o1   = Orient(a,b,f.a);
+    const double o2   = Orient(a,b,f.b);
+    const bool   on1  = std::abs(o1)<=tol;
+    const bool   on2  = std::abs(o2)<=tol;
+
+    if(on1 && on2){
+      const double t1 = param(f.a);
+      const double t2 = param(f.b);
+      const double lo = std::max(0.0, std::min(t1,t2));
+      const double hi = std::min(1.0, std::max(t1,t2));
+      if(hi>lo){
+        cuts.push_back(lo);
+        cuts.push_back(hi);
+        shared.push_back(SharedStretch{lo, hi, fi, dx*(f.b.x-f.a.x)+dy*(f.b.y-f.a.y)>0});
+      }
+      return;
+    }
+
+    //The other edge ends on this one
+    if(on1){
+      const double t = param(f.a);
+      if(t>0 && t<1)
+        cuts.push_back(t);
+    }
+    if(on2){
+      const double t = param(f.b);
+      if(t>0 && t<1)
+        cuts.push_back(t);
+    }
+
+    //The edges cross
+    if(!on1 && !on2 && (o1>0)!=(o2>0)){
+      const double o3 = Orient(f.a,f.b,a);
+      const double o4 = Orient(f.a,f.b,b);
+      if((o3>0 && o4<0) || (o3<0 && o4>0))
+        cuts.push_back(o3/(o3-o4));
+    }
+  });
+}
+
+
+
+double PreparedPolygon::boundaryWithin(const PreparedPolygon &other, const bool keep_shared, const Point2D &origin) const {
+  if(!other.edge_idx)
+    return 0;
+
+  std::vector<double>        cuts;
+  std::vector<SharedStretch> shared;
+
+  double twice_area = 0;
+  for(const auto &e: edges){
+    if(!BoxesOverlap(EdgeBox(e.a,e.b), other.box))
+      continue;
+
+    cuts.assign({0.0, 1.0});
+    shared.clear();
+    SplitEdge(e.a, e.b, other.edges, *other.edge_idx, cuts, shared);
+    std::sort(cuts.begin(), cuts.end());
+
+    for(unsigned int c=1;c<cuts.size();c++){
+      const double t0 = cuts[c-1];
+      const double t1 = cuts[c];
+      if(!(t1-t0>1e-12))
+        continue;
+
+      //Each piece lies wholly inside or outside the other geometry, or along
+      //one of its edges, so its midpoint decides
+      const double mid = (t0+t1)/2;
+      bool keep;
+      const auto sh = std::find_if(shared.begin(), shared.end(), [&](const SharedStretch &x){
+        return x.lo<=mid && mid<=x.hi;
+      });
+      if(sh!=shared.end())
+        keep = keep_shared && sh->same_direction;
+      else
+        keep = other.containsPoint(PointAlong(e, mid));
+
+      if(keep){
+        const auto p = PointAlong(e, t0);
+        const auto q = PointAlong(e, t1);
+        twice_area += (p.x-origin.x)*(q.y-origin.y)-(q.x-origin.x)*(p.y-origin.y);
+      }
+    }
+  }
+
+  return twice_area;
+}
+
+
+
+double IntersectionArea(const PreparedPolygon &a, const PreparedPolygon &b){
+  if(!BoxesOverlap(a.box, b.box))
+    return 0;
+  //Measuring from a nearby origin keeps the products small, and so precise
+  const Point2D origin(a.box.xmin(), a.box.ymin());
+  //Where the two run along the same edge, it is taken from `a` only
+  const double twice_area = a.boundaryWithin(b, true, origin)+b.boundaryWithin(a, false, origin);
+  return std::max(0.0, twice_area/2);
+}
+
+
+
+double IntersectionArea(const MultiPolygon &mp, const PreparedPolygon &prepared){
+  double area;
+  if(TryIntersectionArea(mp, prepared, area))
+    return area;
+  return IntersectionArea(PreparedPolygon(mp), prepared);
+}
+
+
+
+double IntersectionArea(const MultiPolygon &a, const MultiPolygon &b){
+  return IntersectionArea(a, PreparedPolygon(b));
+}
+
+
+
+double IntersectionArea(const Circle &c, const PreparedPolygon &prepared){
+  switch(prepared.classify(c)){
+    case PreparedPolygon::Overlap::Inside:
+      return c.area();
+    case PreparedPolygon::Overlap::Outside:
+      return 0;
+    default:
+      return IntersectionArea(c, prepared.geometry());
+  }
+}
+
+}
@@ -0,0 +1,165 @@
+#ifndef _prepared_polygon_hpp_
+#define _prepared_polygon_hpp_
+
+#include "geom.hpp"
+#include "hilbert_rtree.hpp"
+#include "lazy_cache.hpp"
+#include <memory>
+#include <vector>
+
+namespace complib {
+
+///Point-in-polygon index over the edges of a MultiPolygon. Its y-range is cut
+///into horizontal slabs, and each slab lists the edges crossing it, so a query
+///only looks at the edges at the point's height. Insideness is even-odd: inside
+///an outer ring and not inside one of its holes.
+class PointInPolygonIndex {
+ public:
+  class Edge {
+   public:
+    Point2D a;
+    Point2D b;
+  };
+
+  PointInPolygonIndex() = default;
+  explicit PointInPolygonIndex(const MultiPolygon &mp);
+
+  ///Whether `p` lies within the geometry. Points exactly on the boundary may
+  ///go either way.
+  bool contains(const Point2D &p) const;
+
+ private:
+  std::vector<size_t> slab_offsets; ///< Edges of slab s are slab_edges[slab_offsets[s]] up to slab_edges[slab_offsets[s+1]]
+  std::vector<Edge>   slab_edges;
+  double y0 = 0, y1 = 0;
+  double inv_height = 0;            ///< Slabs per unit of y
+  size_t nslabs = 0;
+
+  size_t slabOf(const double y) const;
+};
+
+
+
+///A stretch of an edge, as parameters along it, which runs along another edge
+class SharedStretch {
+ public:
+  double       lo;
+  double       hi;
+  unsigned int edge;           ///< Index of the other edge
+  bool         same_direction; ///< Whether the other edge runs the same way
+};
+
+///Find where the edge a->b meets `others`, whose boxes are indexed by `idx`.
+///Parameters along a->b at which it must be split are appended to `cuts`, and
+///the stretches where it runs along one of the others to `shared`.
+void SplitEdge(
+  const Point2D &a,
+  const Point2D &b,
+  const std::vector<PointInPolygonIndex::Edge> &others,
+  const PackedHilbertRTree &idx,
+  std::vector<double> &cuts,
+  std::vector<SharedStretch> &shared
+);
+
+
+
+///A MultiPolygon indexed once for repeated queries against it: every edge of
+///every ring goes into a packed R-tree, oriented so that the interior is on its
+///left, and each ring keeps its bounding box and one of its vertices. Intended
+///for superunits (districts, states) which are tested against thousands of
+///subunits. Any number of threads may query it at once. It keeps its own copy
+///of the geometry, so it may outlive the MultiPolygon it was built from.
+///
+///Preparing copies the geometry and builds two indices, so it is never done
+///implicitly: build one explicitly and reuse it for every query.
+class PreparedPolygon {
+ public:
+  typedef PointInPolygonIndex::Edge Edge;
+
+  ///How a polygon lies relative to the prepared geometry
+  enum class Overlap {
+    Inside,   ///< Entirely within it
+    Outside,  ///< Entirely outside it
+    Boundary  ///< The boundaries cross or touch: only clipping will tell
+  };
+
+  PreparedPolygon() = default;
+  explicit PreparedPolygon(const MultiPolygon &mp);
+  explicit PreparedPolygon(const Ring &ring);
+
+  BoundingBox bbox() const;
+
+  ///The geometry which was prepared
+  const MultiPolygon& geometry() const;
+
+  ///Whether `p` lies within the geometry (inside an outer ring and not inside
+  ///one of its holes). Points exactly on the boundary may go either way.
+  bool containsPoint(const Point2D &p) const;
+
+  ///Classify a polygon, holes and all, as inside, outside, or crossing the
+  ///boundary of the geometry. Inside and Outside are exact answers; Boundary
+  ///means the polygon needs to be clipped.
+  Overlap classify(const Polygon &poly) const;
+
+  ///Classify the polygon a single ring (such as a convex hull) bounds
+  Overlap classify(const Ring &ring) const;
+
+  ///Classify a circle's disk in the same way
+  Overlap classify(const Circle &c) const;
+
+  ///The geometry's Clipper paths, converted the first time they are needed
+  const ClipperLib::Paths& clipperPaths() const;
+
+ private:
+  class RingInfo {
+   public:
+    BoundingBox bbox;
+    Point2D     vertex; ///< Any vertex of the ring
+  };
+
+  std::vector<Edge>                         edges;
+  std::vector<RingInfo>                     rings;
+  std::shared_ptr<const PackedHilbertRTree> edge_idx;
+  std::shared_ptr<const MultiPolygon>       geom;
+  PointInPolygonIndex                       pip;
+  BoundingBox                               box;
+  LazyCache<ClipperLib::Paths>              clipper_cache;
+
+  Overlap classifyRings(const Ring *const prings, const size_t n, const BoundingBox &pbox) const;
+
+  //Twice the signed area swept, relative to `origin`, by the pieces of our
+  //edges which lie inside `other`
+  double boundaryWithin(const PreparedPolygon &other, const bool keep_shared, const Point2D &origin) const;
+
+  friend double IntersectionArea(const PreparedPolygon &a, const PreparedPolygon &b);
+};
+
+///Area of the intersection of `sub` with a prepared geometry, if it can be had
+///without clipping: that is, if every polygon of `sub` lies entirely inside or
+///entirely outside `prepared`. Returns false, leaving `area` alone, if some
+///polygon straddles the boundary.
+bool TryIntersectionArea(const MultiPolygon &sub, const PreparedPolygon &prepared, double &area);
+
+///Area of the intersection of two geometries. No intersection polygons are
+///built: the area is integrated directly over the boundary of the intersection,
+///which is made of the pieces of each geometry's edges lying inside the other.
+///Edges are split wherever they meet the other geometry's edges, and edges the
+///two share count once if both geometries lie on the same side of them. Works
+///in doubles throughout. Rings must not cross themselves or each other.
+double IntersectionArea(const PreparedPolygon &a, const PreparedPolygon &b);
+
+///As above. Polygons of `mp` which don't straddle the prepared geometry's
+///boundary are handled without visiting its edges. If any do, `mp` is prepared
+///for this one call: when testing it against several prepared geometries, use
+///TryIntersectionArea() and prepare it yourself only if that fails.
+double IntersectionArea(const MultiPolygon &mp, const PreparedPolygon &prepared);
+
+double IntersectionArea(const MultiPolygon &a, const MultiPolygon &b);
+
+///Area of the intersection of a circle with a prepared geometry. Circles lying
+///wholly inside or outside it need not visit all of its edges.
+double IntersectionArea(const Circle &c, const PreparedPolygon &prepared);
+
+}
+
+#endif
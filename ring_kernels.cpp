@@ -0,0 +1,417 @@
+#include "ring_kernels.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+//The vectorized kernels are compiled with per-function target attributes so
+//that the library as a whole can still be built for (and run on) machines
+//without the instruction sets. The best version is then picked at runtime.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  #define COMPLIB_X86_KERNELS
+  #include <immintrin.h>
+#endif
+
+namespace complib {
+
+static_assert(sizeof(Point2D)==2*sizeof(double), "Point2D must be two packed doubles for the ring kernels!");
+
+namespace {
+
+struct KernelTable {
+  SimdLevel level;
+  double  (*shoelace)(const Point2D *const, const size_t);
+  double  (*path_length)(const Point2D *const, const size_t);
+  void    (*expand_bbox)(const Point2D *const, const size_t, BoundingBox &);
+  Point2D (*coordinate_sum)(const Point2D *const, const size_t);
+  void    (*ring_pass)(const Point2D *const, const size_t, RingPassResult &);
+};
+
+
+
+///////////////////////////////////////////////////////////
+//Scalar kernels
+
+double ShoelaceScalar(const Point2D *const pts, const size_t n){
+  double area = 0;
+  for(size_t i=1;i<n;i++)
+    area += (pts[i-1].x + pts[i].x) * (pts[i-1].y - pts[i].y);
+  return area;
+}
+
+double PathLengthScalar(const Point2D *const pts, const size_t n){
+  double len = 0;
+  for(size_t i=0;i+1<n;i++){
+    const double dx = pts[i+1].x-pts[i].x;
+    const double dy = pts[i+1].y-pts[i].y;
+    len += std::sqrt(dx*dx+dy*dy);
+  }
+  return len;
+}
+
+void ExpandBBoxScalar(const Point2D *const pts, const size_t n, BoundingBox &bb){
+  for(size_t i=0;i<n;i++){
+    bb.xmin() = std::min(bb.xmin(),pts[i].x);
+    bb.xmax() = std::max(bb.xmax(),pts[i].x);
+    bb.ymin() = std::min(bb.ymin(),pts[i].y);
+    bb.ymax() = std::max(bb.ymax(),pts[i].y);
+  }
+}
+
+Point2D CoordinateSumScalar(const Point2D *const pts, const size_t n){
+  Point2D sum(0,0);
+  for(size_t i=0;i<n;i++){
+    sum.x += pts[i].x;
+    sum.y += pts[i].y;
+  }
+  return sum;
+}
+
+//Accumulates the open path (n-1 segments) into `res`
+void RingPassScalar(const Point2D *const pts, const size_t n, RingPassResult &res){
+  for(size_t i=0;i+1<n;i++){
+    const double dx = pts[i+1].x-pts[i].x;
+    const double dy = pts[i+1].y-pts[i].y;
+    res.shoelace += (pts[i].x + pts[i+1].x) * (pts[i].y - pts[i+1].y);
+    res.length   += std::sqrt(dx*dx+dy*dy);
+  }
+  ExpandBBoxScalar(pts, n, res.bbox);
+}
+
+const KernelTable scalar_kernels = {
+  SimdLevel::Scalar, ShoelaceScalar, PathLengthScalar, ExpandBBoxScalar, CoordinateSumScalar, RingPassScalar
+};
+
+
+
+#ifdef COMPLIB_X86_KERNELS
+
+///////////////////////////////////////////////////////////
+//SSE2 kernels: one point per register. Pairs of points are transposed into an
+//x register and a y register so that two segments are handled at once.
+
+__attribute__((target("sse2")))
+double ShoelaceSSE2(const Point2D *const pts, const size_t n){
+  const double *const p = &pts[0].x;
+  __m128d acc = _mm_setzero_pd();
+  size_t i = 1;
+  for(;i+1<n;i+=2){
+    const __m128d a0 = _mm_loadu_pd(p+2*(i-1));
+    const __m128d a1 = _mm_loadu_pd(p+2*i);
+    const __m128d b1 = _mm_loadu_pd(p+2*(i+1));
+    const __m128d xa = _mm_unpacklo_pd(a0,a1);
+    const __m128d ya = _mm_unpackhi_pd(a0,a1);
+    const __m128d xb = _mm_unpacklo_pd(a1,b1);
+    const __m128d yb = _mm_unpackhi_pd(a1,b1);
+    acc = _mm_add_pd(acc, _mm_mul_pd(_mm_add_pd(xa,xb), _mm_sub_pd(ya,yb)));
+  }
+  double lanes[2];
+  _mm_storeu_pd(lanes,acc);
+  double area = lanes[0]+lanes[1];
+  for(;i<n;i++)
+    area += (pts[i-1].x + pts[i].x) * (pts[i-1].y - pts[i].y);
+  return area;
+}
+
+__attribute__((target("sse2")))
+double PathLengthSSE2(const Point2D *const pts, const size_t n){
+  const double *const p = &pts[0].x;
+  __m128d acc = _mm_setzero_pd();
+  size_t i = 0;
+  for(;i+2<n;i+=2){
+    const __m128d a0 = _mm_loadu_pd(p+2*i);
+    const __m128d a1 = _mm_loadu_pd(p+2*(i+1));
+    const __m128d a2 = _mm_loadu_pd(p+2*(i+2));
+    const __m128d dx = _mm_sub_pd(_mm_unpacklo_pd(a1,a2), _mm_unpacklo_pd(a0,a1));
+    const __m128d dy = _mm_sub_pd(_mm_unpackhi_pd(a1,a2), _mm_unpackhi_pd(a0,a1));
+    acc = _mm_add_pd(acc, _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx,dx), _mm_mul_pd(dy,dy))));
+  }
+  double lanes[2];
+  _mm_storeu_pd(lanes,acc);
+  return lanes[0] + lanes[1] + PathLengthScalar(pts+i, n-i);
+}
+
+__attribute__((target("sse2")))
+void ExpandBBoxSSE2(const Point2D *const pts, const size_t n, BoundingBox &bb){
+  const double *const p = &pts[0].x;
+  __m128d mn = _mm_set_pd(bb.ymin(), bb.xmin());
+  __m128d mx = _mm_set_pd(bb.ymax(), bb.xmax());
+  for(size_t i=0;i<n;i++){
+    const __m128d v = _mm_loadu_pd(p+2*i);
+    mn = _mm_min_pd(mn,v);
+    mx = _mm_max_pd(mx,v);
+  }
+  double lmn[2], lmx[2];
+  _mm_storeu_pd(lmn,mn);
+  _mm_storeu_pd(lmx,mx);
+  bb.xmin() = lmn[0];
+  bb.ymin() = lmn[1];
+  bb.xmax() = lmx[0];
+  bb.ymax() = lmx[1];
+}
+
+__attribute__((target("sse2")))
+Point2D CoordinateSumSSE2(const Point2D *const pts, const size_t n){
+  const double *const p = &pts[0].x;
+  __m128d acc = _mm_setzero_pd();
+  for(size_t i=0;i<n;i++)
+    acc = _mm_add_pd(acc, _mm_loadu_pd(p+2*i));
+  double lanes[2];
+  _mm_storeu_pd(lanes,acc);
+  return Point2D(lanes[0],lanes[1]);
+}
+
+__attribute__((target("sse2")))
+void RingPassSSE2(const Point2D *const pts, const size_t n, RingPassResult &res){
+  const double *const p = &pts[0].x;
+  __m128d area = _mm_setzero_pd();
+  __m128d len  = _mm_setzero_pd();
+  __m128d mn   = _mm_set_pd(res.bbox.ymin(), res.bbox.xmin());
+  __m128d mx   = _mm_set_pd(res.bbox.ymax(), res.bbox.xmax());
+  size_t i = 0;
+  for(;i+2<n;i+=2){
+    const __m128d a0 = _mm_loadu_pd(p+2*i);
+    const __m128d a1 = _mm_loadu_pd(p+2*(i+1));
+    const __m128d a2 = _mm_loadu_pd(p+2*(i+2));
+    const __m128d xa = _mm_unpacklo_pd(a0,a1);
+    const __m128d ya = _mm_unpackhi_pd(a0,a1);
+    const __m128d xb = _mm_unpacklo_pd(a1,a2);
+    const __m128d yb = _mm_unpackhi_pd(a1,a2);
+    const __m128d dx = _mm_sub_pd(xb,xa);
+    const __m128d dy = _mm_sub_pd(yb,ya);
+    area = _mm_add_pd(area, _mm_mul_pd(_mm_add_pd(xa,xb), _mm_sub_pd(ya,yb)));
+    len  = _mm_add_pd(len,  _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx,dx), _mm_mul_pd(dy,dy))));
+    mn   = _mm_min_pd(mn, _mm_min_pd(a0,a1));
+    mx   = _mm_max_pd(mx, _mm_max_pd(a0,a1));
+  }
+  double la[2], ll[2], lmn[2], lmx[2];
+  _mm_storeu_pd(la,area);
+  _mm_storeu_pd(ll,len);
+  _mm_storeu_pd(lmn,mn);
+  _mm_storeu_pd(lmx,mx);
+  res.shoelace += la[0]+la[1];
+  res.length   += ll[0]+ll[1];
+  res.bbox.xmin() = lmn[0];
+  res.bbox.ymin() = lmn[1];
+  res.bbox.xmax() = lmx[0];
+  res.bbox.ymax() = lmx[1];
+  RingPassScalar(pts+i, n-i, res);
+}
+
+const KernelTable sse2_kernels = {
+  SimdLevel::SSE2, ShoelaceSSE2, PathLengthSSE2, ExpandBBoxSSE2, CoordinateSumSSE2, RingPassSSE2
+};
+
+
+
+///////////////////////////////////////////////////////////
+//AVX kernels: two points per register. Unpacking two registers gives x and y
+//registers holding four points in the lane order [0,2,1,3]. Since the start
+//and end points of the segments are unpacked the same way the lanes still line
+//up, and the order doesn't matter for the sums.
+
+__attribute__((target("avx")))
+double ShoelaceAVX(const Point2D *const pts, const size_t n){
+  const double *const p = &pts[0].x;
+  __m256d acc = _mm256_setzero_pd();
+  size_t i = 1;
+  for(;i+3<n;i+=4){
+    const __m256d a0 = _mm256_loadu_pd(p+2*(i-1));
+    const __m256d a1 = _mm256_loadu_pd(p+2*(i+1));
+    const __m256d b0 = _mm256_loadu_pd(p+2*i);
+    const __m256d b1 = _mm256_loadu_pd(p+2*(i+2));
+    const __m256d xa = _mm256_unpacklo_pd(a0,a1);
+    const __m256d ya = _mm256_unpackhi_pd(a0,a1);
+    const __m256d xb = _mm256_unpacklo_pd(b0,b1);
+    const __m256d yb = _mm256_unpackhi_pd(b0,b1);
+    acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_add_pd(xa,xb), _mm256_sub_pd(ya,yb)));
+  }
+  double lanes[4];
+  _mm256_storeu_pd(lanes,acc);
+  double area = (lanes[0]+lanes[1])+(lanes[2]+lanes[3]);
+  for(;i<n;i++)
+    area += (pts[i-1].x + pts[i].x) * (pts[i-1].y - pts[i].y);
+  return area;
+}
+
+__attribute__((target("avx")))
+double PathLengthAVX(const Point2D *const pts, const size_t n){
+  const double *const p = &pts[0].x;
+  __m256d acc = _mm256_setzero_pd();
+  size_t i = 0;
+  for(;i+4<n;i+=4){
+    const __m256d a0 = _mm256_loadu_pd(p+2*i);
+    const __m256d a1 = _mm256_loadu_pd(p+2*(i+2));
+    const __m256d b0 = _mm256_loadu_pd(p+2*(i+1));
+    const __m256d b1 = _mm256_loadu_pd(p+2*(i+3));
+    const __m256d dx = _mm256_sub_pd(_mm256_unpacklo_pd(b0,b1), _mm256_unpacklo_pd(a0,a1));
+    const __m256d dy = _mm256_sub_pd(_mm256_unpackhi_pd(b0,b1), _mm256_unpackhi_pd(a0,a1));
+    acc = _mm256_add_pd(acc, _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx,dx), _mm256_mul_pd(dy,dy))));
+  }
+  double lanes[4];
+  _mm256_storeu_pd(lanes,acc);
+  return (lanes[0]+lanes[1])+(lanes[2]+lanes[3]) + PathLengthScalar(pts+i, n-i);
+}
+
+__attribute__((target("avx")))
+void ExpandBBoxAVX(const Point2D *const pts, const size_t n, BoundingBox &bb){
+  const double *const p = &pts[0].x;
+  __m256d mn = _mm256_set_pd(bb.ymin(), bb.xmin(), bb.ymin(), bb.xmin());
+  __m256d mx = _mm256_set_pd(bb.ymax(), bb.xmax(), bb.ymax(), bb.xmax());
+  size_t i = 0;
+  for(;i+1<n;i+=2){
+    const __m256d v = _mm256_loadu_pd(p+2*i);
+    mn = _mm256_min_pd(mn,v);
+    mx = _mm256_max_pd(mx,v);
+  }
+  double lmn[4], lmx[4];
+  _mm256_storeu_pd(lmn,mn);
+  _mm256_storeu_pd(lmx,mx);
+  bb.xmin() = std::min(lmn[0],lmn[2]);
+  bb.ymin() = std::min(lmn[1],lmn[3]);
+  bb.xmax() = std::max(lmx[0],lmx[2]);
+  bb.ymax() = std::max(lmx[1],lmx[3]);
+  ExpandBBoxScalar(pts+i, n-i, bb);
+}
+
+__attribute__((target("avx")))
+Point2D CoordinateSumAVX(const Point2D *const pts, const size_t n){
+  const double *const p = &pts[0].x;
+  __m256d acc = _mm256_setzero_pd();
+  size_t i = 0;
+  for(;i+1<n;i+=2)
+    acc = _mm256_add_pd(acc, _mm256_loadu_pd(p+2*i));
+  double lanes[4];
+  _mm256_storeu_pd(lanes,acc);
+  Point2D sum(lanes[0]+lanes[2], lanes[1]+lanes[3]);
+  if(i<n){
+    sum.x += pts[i].x;
+    sum.y += pts[i].y;
+  }
+  return sum;
+}
+
+__attribute__((target("avx")))
+void RingPassAVX(const Point2D *const pts, const size_t n, RingPassResult &res){
+  const double *const p = &pts[0].x;
+  __m256d area = _mm256_setzero_pd();
+  __m256d len  = _mm256_setzero_pd();
+  __m256d mn   = _mm256_set_pd(res.bbox.ymin(), res.bbox.xmin(), res.bbox.ymin(), res.bbox.xmin());
+  __m256d mx   = _mm256_set_pd(res.bbox.ymax(), res.bbox.xmax(), res.bbox.ymax(), res.bbox.xmax());
+  size_t i = 0;
+  for(;i+4<n;i+=4){
+    const __m256d a0 = _mm256_loadu_pd(p+2*i);
+    const __m256d a1 = _mm256_loadu_pd(p+2*(i+2));
+    const __m256d b0 = _mm256_loadu_pd(p+2*(i+1));
+    const __m256d b1 = _mm256_loadu_pd(p+2*(i+3));
+    const __m256d xa = _mm256_unpacklo_pd(a0,a1);
+    const __m256d ya = _mm256_unpackhi_pd(a0,a1);
+    const __m256d xb = _mm256_unpacklo_pd(b0,b1);
+    const __m256d yb = _mm256_unpackhi_pd(b0,b1);
+    const __m256d dx = _mm256_sub_pd(xb,xa);
+    const __m256d dy = _mm256_sub_pd(yb,ya);
+    area = _mm256_add_pd(area, _mm256_mul_pd(_mm256_add_pd(xa,xb), _mm256_sub_pd(ya,yb)));
+    len  = _mm256_add_pd(len,  _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx,dx), _mm256_mul_pd(dy,dy))));
+    mn   = _mm256_min_pd(mn, _mm256_min_pd(a0,a1));
+    mx   = _mm256_max_pd(mx, _mm256_max_pd(a0,a1));
+  }
+  double la[4], ll[4], lmn[4], lmx[4];
+  _mm256_storeu_pd(la,area);
+  _mm256_storeu_pd(ll,len);
+  _mm256_storeu_pd(lmn,mn);
+  _mm256_storeu_pd(lmx,mx);
+  res.shoelace += (la[0]+la[1])+(la[2]+la[3]);
+  res.length   += (ll[0]+ll[1])+(ll[2]+ll[3]);
+  res.bbox.xmin() = std::min(lmn[0],lmn[2]);
+  res.bbox.ymin() = std::min(lmn[1],lmn[3]);
+  res.bbox.xmax() = std::max(lmx[0],lmx[2]);
+  res.bbox.ymax() = std::max(lmx[1],lmx[3]);
+  RingPassScalar(pts+i, n-i, res);
+}
+
+const KernelTable avx_kernels = {
+  SimdLevel::AVX, ShoelaceAVX, PathLengthAVX, ExpandBBoxAVX, CoordinateSumAVX, RingPassAVX
+};
+
+#endif //COMPLIB_X86_KERNELS
+
+
+
+const KernelTable* TableForLevel(const SimdLevel level){
+  switch(level){
+    #ifdef COMPLIB_X86_KERNELS
+    case SimdLevel::AVX:  return &avx_kernels;
+    case SimdLevel::SSE2: return &sse2_kernels;
+    #endif
+    default:              return &scalar_kernels;
+  }
+}
+
+std::atomic<const KernelTable*> active_kernels(nullptr);
+
+const KernelTable& Kernels(){
+  const KernelTable *table = active_kernels.load(std::memory_order_acquire);
+  if(table)
+    return *table;
+  table = TableForLevel(DetectSimdLevel());
+  active_kernels.store(table, std::memory_order_release);
+  return *table;
+}
+
+}
+
+
+
+SimdLevel DetectSimdLevel(){
+  #ifdef COMPLIB_X86_KERNELS
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx"))
+      return SimdLevel::AVX;
+    if(__builtin_cpu_supports("sse2"))
+      return SimdLevel::SSE2;
+  #endif
+  return SimdLevel::Scalar;
+}
+
+SimdLevel GetSimdLevel(){
+  return Kernels().level;
+}
+
+SimdLevel SetSimdLevel(const SimdLevel level){
+  const SimdLevel use = std::min(level, DetectSimdLevel());
+  active_kernels.store(TableForLevel(use), std::memory_order_release);
+  return use;
+}
+
+double ShoelaceSum(const Point2D *const pts, const size_t n){
+  if(n<2)
+    return 0;
+  //Closing term joins the last point back to the first
+  return Kernels().shoelace(pts,n) + (pts[n-1].x + pts[0].x) * (pts[n-1].y - pts[0].y);
+}
+
+double PathLength(const Point2D *const pts, const size_t n){
+  return Kernels().path_length(pts,n);
+}
+
+void ExpandBBox(const Point2D *const pts, const size_t n, BoundingBox &bb){
+  Kernels().expand_bbox(pts,n,bb);
+}
+
+Point2D CoordinateSum(const Point2D *const pts, const size_t n){
+  return Kernels().coordinate_sum(pts,n);
+}
+
+RingPassResult RingPass(const Point2D *const pts, const size_t n){
+  RingPassResult res;
+  if(n==0)
+    return res;
+  Kernels().ring_pass(pts,n,res);
+  //Closing segment joins the last point back to the first
+  const double dx = pts[0].x-pts[n-1].x;
+  const double dy = pts[0].y-pts[n-1].y;
+  res.shoelace += (pts[n-1].x + pts[0].x) * (pts[n-1].y - pts[0].y);
+  res.length   += std::sqrt(dx*dx+dy*dy);
+  return res;
+}
+
+}
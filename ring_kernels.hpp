@@ -0,0 +1,44 @@
+#ifndef _ring_kernels_hpp_
+#define _ring_kernels_hpp_
+
+#include "geom.hpp"
+#include <cstddef>
+
+namespace complib {
+  //Instruction sets the ring kernels can be run with. The best one the CPU
+  //supports is chosen the first time a kernel is used.
+  enum class SimdLevel {
+    Scalar,
+    SSE2,
+    AVX
+  };
+
+  SimdLevel DetectSimdLevel();
+  SimdLevel GetSimdLevel();
+  ///Force a particular instruction set (used by tests/benchmarks). Levels the
+  ///CPU does not support are clamped to the best available one. Returns the
+  ///level actually in use.
+  SimdLevel SetSimdLevel(const SimdLevel level);
+
+  ///Sum of (x[i-1]+x[i])*(y[i-1]-y[i]) around the ring (twice its signed area)
+  double  ShoelaceSum  (const Point2D *const pts, const size_t n);
+  ///Sum of the lengths of the n-1 segments joining consecutive points
+  double  PathLength   (const Point2D *const pts, const size_t n);
+  ///Grow the bounding box to include all the points
+  void    ExpandBBox   (const Point2D *const pts, const size_t n, BoundingBox &bb);
+  ///Componentwise sum of the points
+  Point2D CoordinateSum(const Point2D *const pts, const size_t n);
+
+  class RingPassResult {
+   public:
+    double      shoelace = 0; ///< Twice the signed area of the closed ring
+    double      length   = 0; ///< Perimeter of the closed ring
+    BoundingBox bbox;
+  };
+
+  ///Shoelace sum, perimeter, and bounding box of a closed ring in a single pass
+  ///over its coordinates
+  RingPassResult RingPass(const Point2D *const pts, const size_t n);
+}
+
+#endif
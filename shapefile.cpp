@@ -8,7 +8,9 @@
 #include <set>
 #include <fstream>
 #include <sstream>
+#include <utility>
 #include "geom.hpp"
+#include "flat_geom.hpp"
 
 namespace complib {
 
@@ -49,7 +51,16 @@ static bool IsHole(const SHPObject *const psCShape, const int ringi){
 
 
 
-static void ReadShapeAttributes(GeoCollection &gc, std::string filename){
+static Props& FeatureProps(FlatGeoCollection &fc, const int f){
+  return fc.props.at(f);
+}
+
+static Props& FeatureProps(GeoCollectionBuilder &builder, const int f){
+  return builder.gc.at(f).props;
+}
+
+template<class Builder>
+static void ReadShapeAttributes(Builder &fc, std::string filename){
   DBFHandle hDBF = DBFOpen( filename.c_str(), "rb" );
   if( hDBF == NULL )
     throw std::runtime_error("Failed to open file '"+filename+"'!");
@@ -105,7 +116,7 @@ static void ReadShapeAttributes(GeoCollection &gc, std::string filename){
 
       //GRAB ATTRIBUTES WITHOUT DECODING THEM INTO USABLE DATA
       const auto attrib = DBFReadStringAttribute( hDBF, iRecord, i );
-      gc.at(iRecord).props[szTitle] = attrib;
+      FeatureProps(fc,iRecord)[szTitle] = attrib;
     }
   }
 
@@ -118,7 +129,8 @@ static void ReadShapeAttributes(GeoCollection &gc, std::string filename){
 
 
 //TODO: Do we need to worry about layers?
-void ReadShapes(GeoCollection &mgons, std::string filename){
+template<class Builder>
+static void ReadShapes(Builder &fc, std::string filename){
   int nShapeType;
   int nEntities;
   double adfMinBound[4];
@@ -133,11 +145,17 @@ void ReadShapes(GeoCollection &mgons, std::string filename){
   if(nShapeType!=SHPT_POLYGON && nShapeType!=SHPT_POLYGONZ)
     throw std::runtime_error("Can only work with SHPT_POLYGON and SHPT_POLYGONZ shapefiles!");
 
+  //Every polygon record holds a 52-byte header (record header, type, bounding
+  //box, counts) and at least 16 bytes per vertex (24 with z values) after the
+  //file's 100-byte header, so the file's size bounds its number of vertices.
+  //Reserving that once lets the points be loaded without reallocating.
+  const size_t record_bytes = 52*(size_t)nEntities+100;
+  const size_t vertex_bytes = (nShapeType==SHPT_POLYGONZ) ? 24 : 16;
+  const size_t max_vertices = hSHP->nFileSize>record_bytes ? (hSHP->nFileSize-record_bytes)/vertex_bytes : 0;
+  fc.reserve(max_vertices, 0, 0, nEntities);
+
   SHPObject *psShape;
   for(int i=0;i<nEntities;i++){
-    mgons.emplace_back();     //Add a new MultiPolygon 
-    auto &mp = mgons.back();  //Get a reference to it
-
     psShape = SHPReadObject( hSHP, i );
     if(psShape==NULL)
       throw std::runtime_error("Couldn't load shape!");
@@ -145,19 +163,30 @@ void ReadShapes(GeoCollection &mgons, std::string filename){
     if( psShape->nParts > 0 && psShape->panPartStart[0] != 0 )
       throw std::runtime_error("panPartStart[0] should be 0, but is not!");
 
-    //Loop through all the vertices of the multipolygon
-    int ringi = 0; //Which ring we're considering
-    for(int j=0; j < psShape->nVertices; j++ ){
-      if( ringi < psShape->nParts && psShape->panPartStart[ringi] == j ){
-        if(!IsHole(psShape,ringi))
-          mp.emplace_back();
-        mp.back().emplace_back();
-        ringi++;
+    //Loop through all the rings of the multipolygon. An outer ring starts a new
+    //polygon; holes belong to the polygon before them.
+    for(int ringi=0; ringi < psShape->nParts; ringi++){
+      const int first_vtx = psShape->panPartStart[ringi];
+      const int last_vtx  = (ringi==psShape->nParts-1) ? psShape->nVertices : psShape->panPartStart[ringi+1];
+
+      if(!IsHole(psShape,ringi)){
+        if(fc.polygonOpen())
+          fc.endPolygon();
+      } else if(!fc.polygonOpen()){
+        throw std::runtime_error("Shapefile had a hole before any outer ring!");
       }
-      
+
       //if(psShape->bMeasureIsUsed){
-      mp.back().back().emplace_back(psShape->padfX[j], psShape->padfY[j]);
+      for(int j=first_vtx;j<last_vtx;j++)
+        fc.addPoint(psShape->padfX[j], psShape->padfY[j]);
+
+      if(last_vtx<=first_vtx || !(psShape->padfX[first_vtx]==psShape->padfX[last_vtx-1] && psShape->padfY[first_vtx]==psShape->padfY[last_vtx-1]))
+        throw std::runtime_error("Shapefile had an unclosed ring!");
+      fc.endRing();
     }
+    if(fc.polygonOpen())
+      fc.endPolygon();
+    fc.endFeature();
 
     SHPDestroyObject( psShape );
   }
@@ -165,7 +194,7 @@ void ReadShapes(GeoCollection &mgons, std::string filename){
   SHPClose( hSHP );
 }
 
-void ReadShapeProj(GeoCollection &gc, std::string filename){
+static std::string ReadShapeProj(std::string filename){
   if(filename.size()>=4 && filename.substr(filename.size()-4)==".shp")
     filename = filename.substr(0,filename.size()-4);
   filename += ".prj";
@@ -173,27 +202,31 @@ void ReadShapeProj(GeoCollection &gc, std::string filename){
   std::ifstream fin(filename);
   std::stringstream buffer;
   buffer << fin.rdbuf();
-  gc.prj_str = buffer.str();
+  return buffer.str();
+}
+
+FlatGeoCollection ReadShapefileFlat(std::string filename){
+  FlatGeoCollection fc;
+
+  ReadShapes(fc,filename);
+  ReadShapeAttributes(fc,filename);
+  fc.prj_str = ReadShapeProj(filename);
+
+  fc.correctWindingDirection();
+
+  return fc;
 }
 
 GeoCollection ReadShapefile(std::string filename){
-  GeoCollection mgons;
-  
-  ReadShapes(mgons,filename);
-  ReadShapeAttributes(mgons,filename);
-  ReadShapeProj(mgons,filename);
-
-  //TODO
-  for(auto &mp: mgons)
-  for(auto &poly: mp)
-  for(auto &ring: poly){
-    if(!(ring.front().x==ring.back().x && ring.front().y==ring.back().y))
-      throw std::runtime_error("Shapefile had an unclosed ring!");
-  }
+  GeoCollectionBuilder builder;
+
+  ReadShapes(builder,filename);
+  ReadShapeAttributes(builder,filename);
+  builder.gc.prj_str = ReadShapeProj(filename);
 
-  mgons.correctWindingDirection();
+  builder.gc.correctWindingDirection();
 
-  return mgons;
+  return std::move(builder.gc);
 }
 
 
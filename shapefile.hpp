@@ -3,8 +3,10 @@
 
 #include <string>
 #include "geom.hpp"
+#include "flat_geom.hpp"
 
 namespace complib {
+  FlatGeoCollection ReadShapefileFlat(std::string filename);
   GeoCollection ReadShapefile(std::string filename);
   void WriteShapefile(const GeoCollection &gc, const std::string filename);
   void WriteShapeScores(const GeoCollection &gc, const std::string filename);
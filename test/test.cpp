@@ -5,15 +5,41 @@
 #include <map>
 #include <iostream>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 
 using namespace complib;
 
+//An axis-aligned rectangle, wound counter-clockwise
+static Ring RectRing(const double x0, const double y0, const double x1, const double y1){
+  return Ring(Points{{x0,y0},{x1,y0},{x1,y1},{x0,y1},{x0,y0}});
+}
+
+static MultiPolygon Rect(const double x0, const double y0, const double x1, const double y1){
+  MultiPolygon mp;
+  mp.emplace_back();
+  mp.back().emplace_back(RectRing(x0,y0,x1,y1));
+  return mp;
+}
+
+//A grid of nx by ny unit squares, with its lower-left corner at the origin,
+//numbered row by row
+static GeoCollection UnitSquareGrid(const int nx, const int ny){
+  GeoCollection gc;
+  for(int y=0;y<ny;y++)
+  for(int x=0;x<nx;x++)
+    gc.push_back(Rect(x,y,x+1,y+1));
+  return gc;
+}
+
 TEST_CASE("Data test"){
   auto gc = complib::ReadShapefile("test_data/cb_2015_us_cd114_20m.shp");
+  gc.clipperify();
   for(const auto &mp: gc)
     CHECK(areaExcludingHoles(mp)>0);
   for(const auto &mp: gc)
-    CHECK(IntersectionArea(mp,mp.getHull())>0);
+    CHECK(IntersectionArea(mp,PreparedPolygon(mp.getHull()))>0);
   CHECK(gc.size()==216);
   for(const auto &mp: gc){
     if(mp.props.at("GEOID")=="1307"){
@@ -46,6 +72,22 @@ TEST_CASE("Square Test"){
   SUBCASE("Bounding Circle"){
     const auto circle = GetBoundingCircle(mp);
     CHECK(areaIncludingHoles(circle)==doctest::Approx(2*M_PI));
+    const auto mec = MinimumEnclosingCircle(mp);
+    CHECK(mec.center.x==doctest::Approx(1));
+    CHECK(mec.center.y==doctest::Approx(1));
+    CHECK(mec.radius==doctest::Approx(std::sqrt(2)));
+    CHECK(ScoreReockPS(mp)==doctest::Approx(4/(2*M_PI)));
+  }
+
+  SUBCASE("Enclosing circles of triangles"){
+    //Obtuse: the longest side is a diameter
+    const auto obtuse = MinimumEnclosingCircle(Points{{0,0},{10,0},{5,1}});
+    CHECK(obtuse.radius==doctest::Approx(5));
+    CHECK(obtuse.center.x==doctest::Approx(5));
+    CHECK(obtuse.center.y==doctest::Approx(0));
+    //Equilateral: the circumcircle
+    const auto equi = MinimumEnclosingCircle(Points{{0,0},{2,0},{1,std::sqrt(3)}});
+    CHECK(equi.radius==doctest::Approx(2/std::sqrt(3)));
   }
 }
 
@@ -73,6 +115,453 @@ TEST_CASE("Circle"){
   CHECK(ScoreReockPT(mp)==doctest::Approx(1.0));
 }
 
+TEST_CASE("Ring kernels"){
+  //Irregular ring with an odd number of points so the vector tails get used
+  Ring ring;
+  for(int i=0;i<1001;i++){
+    const double r = 1000+50*std::sin(17.0*i);
+    ring.emplace_back(r*std::cos(2*M_PI*i/1001.0)+3e5, r*std::sin(2*M_PI*i/1001.0)+4e6);
+  }
+  ring.push_back(ring.front());
+  MultiPolygon mp;
+  mp.emplace_back();
+  mp.back().push_back(ring);
+
+  const auto detected = DetectSimdLevel();
+  SetSimdLevel(SimdLevel::Scalar);
+  const double  area0 = area(ring);
+  const double  perim0 = perim(ring);
+  const auto    bb0    = mp.bbox();
+  const Point2D cent0  = CentroidPTSH(mp);
+
+  for(const auto level: {SimdLevel::SSE2, SimdLevel::AVX}){
+    SetSimdLevel(level);
+    ring.clearCache();
+    mp.clearCache();
+    CHECK(area(ring)==doctest::Approx(area0));
+    CHECK(perim(ring)==doctest::Approx(perim0));
+    const auto bb = mp.bbox();
+    CHECK(bb.xmin()==bb0.xmin());
+    CHECK(bb.ymin()==bb0.ymin());
+    CHECK(bb.xmax()==bb0.xmax());
+    CHECK(bb.ymax()==bb0.ymax());
+    const Point2D cent = CentroidPTSH(mp);
+    CHECK(cent.x==doctest::Approx(cent0.x));
+    CHECK(cent.y==doctest::Approx(cent0.y));
+    CHECK(ShoelaceSum(ring.v.data(),ring.size())==doctest::Approx(-2*area0));
+    CHECK(PathLength(ring.v.data(),ring.size())==doctest::Approx(perim0));
+  }
+
+  SetSimdLevel(detected);
+}
+
+TEST_CASE("Geometry summary"){
+  const std::string inita = "{\"type\":\"FeatureCollection\",\"features\":[{\"type\":\"Feature\",\"properties\":{},\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[[[0,0],[4,0],[4,4],[0,4],[0,0]],[[1,1],[2,1],[2,2],[1,2],[1,1]]]}}]}";
+  auto gca = ReadGeoJSON(inita);
+  auto &mp = gca.at(0);
+
+  const auto &s = mp.summary();
+  CHECK(s.area==16);
+  CHECK(s.perim==16);
+  CHECK(s.hole_area==1);
+  CHECK(s.hole_perim==4);
+  CHECK(s.vertex_count==10);
+  CHECK(s.bbox.xmin()==0);
+  CHECK(s.bbox.ymax()==4);
+  CHECK(mp.at(0).at(0).summary().signed_area==16);
+
+  //Changing the geometry through the library drops the cached summary
+  mp.reverse();
+  CHECK(mp.at(0).at(0).summary().signed_area==-16);
+  CHECK(mp.summary().area==16);
+
+  //So does editing it through the members the geometry types expose
+  mp.reverse();
+  CHECK(mp.summary().area==16);
+  mp[0][0][2].x = 8;
+  CHECK(mp.summary().area==24);
+  CHECK(mp.getHull().summary().area==24);
+  mp.emplace_back();
+  mp.back().push_back(mp.front().front());
+  CHECK(mp.summary().area==48);
+  CHECK(mp.summary().vertex_count==15);
+
+  //Values handed out before an edit stay alive, describing the old geometry
+  const auto &old_summary = mp.summary();
+  const auto &old_hull    = mp.getHull();
+  mp[1][0][2].x = 12;
+  CHECK(old_summary.area==48);
+  CHECK(old_hull.summary().area==24);
+  CHECK(mp.summary().area==56);
+  CHECK(&mp.summary()!=&old_summary);
+}
+
+TEST_CASE("Flat geometry store"){
+  const auto fc = ReadShapefileFlat("test_data/cb_2015_us_cd114_20m.shp");
+  const auto gc = ReadShapefile("test_data/cb_2015_us_cd114_20m.shp");
+  REQUIRE(fc.size()==gc.size());
+  CHECK(fc.points.size()==(size_t)std::accumulate(gc.begin(), gc.end(), 0, [](const int a, const MultiPolygon &mp){ return a+PointCount(mp); }));
+  CHECK(fc.prj_str==gc.prj_str);
+
+  for(size_t f=0;f<fc.size();f++){
+    const auto fv = fc[f];
+    const auto &mp = gc.at(f);
+    REQUIRE(fv.size()==mp.size());
+    CHECK(fv.props()==mp.props);
+    CHECK(fv.area()==mp.summary().area);
+    CHECK(fv.perim()==mp.summary().perim);
+    CHECK(fv.summary().hole_area==mp.summary().hole_area);
+    CHECK(fv.summary().vertex_count==mp.summary().vertex_count);
+    CHECK(fv.bbox().xmin()==mp.bbox().xmin());
+    CHECK(fv.bbox().ymax()==mp.bbox().ymax());
+    CHECK(fv.getHull().v.size()==mp.getHull().size());
+    CHECK(fv.getHull().summary().area==doctest::Approx(mp.getHull().summary().area));
+    for(size_t p=0;p<fv.size();p++)
+      CHECK(fv.polygon(p).size()==mp.at(p).size());
+  }
+
+  //Round trips through the nested representation
+  const FlatGeoCollection again(gc);
+  CHECK(again.points.size()==fc.points.size());
+  CHECK(again.ring_offsets==fc.ring_offsets);
+  CHECK(again.polygon_offsets==fc.polygon_offsets);
+  CHECK(again.feature_offsets==fc.feature_offsets);
+  const auto mp = fc[3].toMultiPolygon();
+  CHECK(mp.summary().area==gc.at(3).summary().area);
+
+  //The other readers fill the same store
+  const std::string wktstr = "MULTIPOLYGON (((0 0, 4 0, 4 4, 0 4, 0 0), (1 1, 2 1, 2 2, 1 2, 1 1)), ((5 5, 6 5, 6 6, 5 6, 5 5)))";
+  const auto wkt = ReadWKTFlat(wktstr);
+  REQUIRE(wkt.size()==1);
+  CHECK(wkt.polygonCount()==2);
+  CHECK(wkt.ringCount()==3);
+  CHECK(wkt[0].area()==17);
+  CHECK(wkt[0].summary().hole_area==1);
+  CHECK(wkt[0].polygon(0).ring(1).perim()==4);
+  const auto nested = ReadWKT(wktstr);
+  REQUIRE(nested.size()==1);
+  CHECK(nested.at(0).size()==2);
+  CHECK(nested.at(0).at(0).size()==2);
+  CHECK(nested.at(0).summary().area==wkt[0].area());
+
+  const auto json = ReadGeoJSONFlat("{\"type\":\"FeatureCollection\",\"features\":[{\"type\":\"Feature\",\"properties\":{\"a\":1},\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[[[0,0],[2,0],[2,2],[0,2],[0,0]]]}},{\"type\":\"Feature\",\"properties\":{},\"geometry\":{\"type\":\"MultiPolygon\",\"coordinates\":[[[[0,0],[1,0],[1,1],[0,1],[0,0]]],[[[3,0],[4,0],[4,1],[3,0]]]]}}]}");
+  REQUIRE(json.size()==2);
+  CHECK(json[0].props().at("a")=="1");
+  CHECK(json[1].size()==2);
+  CHECK(json[1].area()==1.5);
+  CHECK(json[1].getHull().summary().area==4);
+
+  FlatGeoCollection built;
+  CHECK_THROWS(built.endRing());
+  CHECK_THROWS(built.endPolygon());
+  GeoCollectionBuilder builder;
+  CHECK_THROWS(builder.endRing());
+  CHECK_THROWS(builder.endPolygon());
+}
+
+TEST_CASE("Rotating calipers"){
+  //Jagged ring whose hull has many vertices
+  Ring ring;
+  for(int i=0;i<500;i++){
+    const double r = 100+10*std::sin(7.0*i)+(i%3);
+    ring.emplace_back(1.5*r*std::cos(2*M_PI*i/500.0), r*std::sin(2*M_PI*i/500.0));
+  }
+  ring.push_back(ring.front());
+
+  const auto hull = ring.getHull();
+  double brute = 0;
+  for(unsigned int i=0;i<hull.size();i++)
+  for(unsigned int j=i+1;j<hull.size();j++)
+    brute = std::max(brute,EuclideanDistance(hull.at(i),hull.at(j)));
+
+  CHECK(diameter(ring)==doctest::Approx(brute));
+
+  MultiPolygon mp;
+  mp.emplace_back();
+  mp.back().push_back(ring);
+  const auto pts = MostDistantPoints(mp);
+  CHECK(EuclideanDistance(pts.first,pts.second)==doctest::Approx(brute));
+  CHECK(diameterOfEntireMultiPolygon(mp)==doctest::Approx(brute));
+}
+
+TEST_CASE("Calculate all unbounded scores"){
+  auto gc = complib::ReadShapefile("test_data/cb_2015_us_cd114_20m.shp");
+  CalculateAllUnboundedScores(gc);
+  for(const auto &mp: gc){
+    CHECK(mp.scores.at("PolsbyPopp")==ScorePolsbyPopper(mp));
+    CHECK(mp.scores.at("CvxHullPT")==ScoreConvexHullPT(mp));
+    CHECK(mp.scores.at("ReockPT")==ScoreReockPT(mp));
+  }
+
+  //Copies carry their caches with them
+  const auto copy = gc.at(0);
+  CHECK(copy.getHull().size()==gc.at(0).getHull().size());
+  CHECK(areaIncludingHoles(copy)==areaIncludingHoles(gc.at(0)));
+}
+
+TEST_CASE("Melkman hull"){
+  //Star-shaped (simple but very non-convex) ring
+  Ring star;
+  for(int i=0;i<400;i++){
+    const double r = (i%2==0) ? 100 : 30+(i%7);
+    star.emplace_back(r*std::cos(2*M_PI*i/400.0), r*std::sin(2*M_PI*i/400.0));
+  }
+  star.push_back(star.front());
+  //Reversed copy checks the clockwise case
+  Ring rstar = star;
+  std::reverse(rstar.begin(),rstar.end());
+
+  //Hull of a set of points via a different route: hull of the multipolygon
+  MultiPolygon mp;
+  mp.emplace_back();
+  mp.back().push_back(star);
+  CHECK(area(star.getHull())==doctest::Approx(area(mp.getHull())));
+  CHECK(area(rstar.getHull())==doctest::Approx(area(mp.getHull())));
+  CHECK(star.getHull().size()==mp.getHull().size());
+
+  //A self-intersecting "bowtie" fools Melkman's algorithm, so we should fall
+  //back to the general algorithm and still get the square
+  Ring bowtie(std::vector<Point2D>{{0,0},{2,2},{2,0},{0,2},{0,0}});
+  CHECK(area(bowtie.getHull())==4);
+
+  //Nor is a ring which goes round twice
+  Ring twice = star;
+  twice.v.pop_back();
+  twice.v.insert(twice.v.end(), star.begin(), star.end());
+  CHECK(area(twice.getHull())==doctest::Approx(area(star.getHull())));
+  CHECK(twice.getHull().size()==star.getHull().size());
+}
+
+TEST_CASE("Multipolygon hull"){
+  const std::string islands = "{\"type\":\"MultiPolygon\",\"coordinates\":[[[[0,0],[1,0],[1,1],[0,1],[0,0]],[[0.2,0.2],[0.4,0.2],[0.4,0.4],[0.2,0.2]]],[[[3,0],[4,0],[4,1],[3,1],[3,0]]],[[[2,0.2],[2.5,0.5],[2,0.8],[2,0.2]]]]}";
+  auto gc = ReadGeoJSON(islands);
+  const auto &hull = gc.at(0).getHull();
+  CHECK(area(hull)==doctest::Approx(4));
+  CHECK(hull.size()==5); //Four corners plus the closing point
+  CHECK(ScoreConvexHullPT(gc.at(0))==doctest::Approx((2+0.15)/4.0));
+}
+
+TEST_CASE("Circle-polygon intersection area"){
+  const std::string holed = "{\"type\":\"Polygon\",\"coordinates\":[[[0,0],[4,0],[4,4],[0,4],[0,0]],[[1,1],[2,1],[2,2],[1,2],[1,1]]]}";
+  auto gc = ReadGeoJSON(holed);
+  const auto &mp = gc.at(0);
+
+  //Entirely inside the polygon
+  CHECK(IntersectionArea(Circle(Point2D(3,3),0.5),mp)==doctest::Approx(M_PI*0.25));
+  //Quarter of the circle is in the polygon
+  CHECK(IntersectionArea(Circle(Point2D(0,0),1),mp)==doctest::Approx(M_PI/4));
+  //Entirely inside the hole
+  CHECK(IntersectionArea(Circle(Point2D(1.5,1.5),0.4),mp)==doctest::Approx(0));
+  //Circle contains everything
+  CHECK(IntersectionArea(Circle(Point2D(2,2),10),mp)==doctest::Approx(15));
+  //Centered on an edge, so half of the circle is inside
+  CHECK(IntersectionArea(Circle(Point2D(4,3),0.5),mp)==doctest::Approx(M_PI*0.25/2));
+  //Ring orientation does not matter
+  gc.reverse();
+  CHECK(IntersectionArea(Circle(Point2D(0,0),1),gc.at(0))==doctest::Approx(M_PI/4));
+
+  //The minimum enclosing circle of a 2x2 square has radius sqrt(2), so it
+  //covers 4 units of a big enclosing border
+  const std::string square = "{\"type\":\"Polygon\",\"coordinates\":[[[0,0],[2,0],[2,2],[0,2],[0,0]]]}";
+  const std::string border = "{\"type\":\"Polygon\",\"coordinates\":[[[-10,-10],[10,-10],[10,10],[-10,10],[-10,-10]]]}";
+  const auto sq = ReadGeoJSON(square);
+  const auto bo = ReadGeoJSON(border);
+  CHECK(ScoreReockPTB(sq.at(0),PreparedPolygon(bo.at(0)))==doctest::Approx(4/(2*M_PI)));
+}
+
+TEST_CASE("Convex intersection area"){
+  //A U-shape (non-convex) with a hole in its base
+  const std::string ushape = "{\"type\":\"Polygon\",\"coordinates\":[[[0,0],[6,0],[6,6],[4,6],[4,2],[2,2],[2,6],[0,6],[0,0]],[[1,0.5],[5,0.5],[5,1.5],[1,1.5],[1,0.5]]]}";
+  auto gc = ReadGeoJSON(ushape);
+  const auto &mp = gc.at(0);
+
+  //Covers the top of both arms and the gap between them
+  CHECK(ConvexIntersectionArea(RectRing(0,4,6,6),mp)==doctest::Approx(8));
+  //Covers the base, including its hole
+  CHECK(ConvexIntersectionArea(RectRing(0,0,6,2),mp)==doctest::Approx(8));
+  //Entirely within the gap
+  CHECK(ConvexIntersectionArea(RectRing(2.5,3,3.5,5),mp)==doctest::Approx(0));
+  //Covers everything
+  CHECK(ConvexIntersectionArea(RectRing(-1,-1,7,7),mp)==doctest::Approx(24));
+  //Triangle cutting diagonally across the base and a corner of its hole
+  CHECK(ConvexIntersectionArea(Ring(Points{{0,0},{2,0},{0,2},{0,0}}),mp)==doctest::Approx(2-0.125));
+  //Winding of either operand does not matter
+  auto rev = RectRing(0,4,6,6);
+  std::reverse(rev.begin(),rev.end());
+  gc.reverse();
+  CHECK(ConvexIntersectionArea(rev,gc.at(0))==doctest::Approx(8));
+
+  //The U's hull is the 6x6 square, all of which lies within the border. The
+  //score compares against the U's area with its hole filled in.
+  const std::string border = "{\"type\":\"Polygon\",\"coordinates\":[[[-10,-10],[10,-10],[10,10],[-10,10],[-10,-10]]]}";
+  const auto bo = ReadGeoJSON(border);
+  CHECK(ScoreConvexHullPTB(mp,PreparedPolygon(bo.at(0)))==doctest::Approx(28/36.));
+}
+
+TEST_CASE("Prepared polygon"){
+  //A U-shape (non-convex) with a hole in its base
+  const std::string ushape = "{\"type\":\"Polygon\",\"coordinates\":[[[0,0],[6,0],[6,6],[4,6],[4,2],[2,2],[2,6],[0,6],[0,0]],[[1,0.5],[5,0.5],[5,1.5],[1,1.5],[1,0.5]]]}";
+  auto gc = ReadGeoJSON(ushape);
+  const PreparedPolygon prep(gc.at(0));
+
+  CHECK(prep.containsPoint(Point2D(0.5,3)));
+  CHECK(!prep.containsPoint(Point2D(3,3)));   //In the gap between the arms
+  CHECK(!prep.containsPoint(Point2D(3,1)));   //In the hole
+  CHECK(!prep.containsPoint(Point2D(7,1)));
+
+  typedef PreparedPolygon::Overlap Overlap;
+  CHECK(prep.classify(Rect(0.2,3,1.8,5).at(0))==Overlap::Inside);
+  CHECK(prep.classify(Rect(2.5,3,3.5,5).at(0))==Overlap::Outside);
+  CHECK(prep.classify(Rect(2,1,3,1.2).at(0))==Overlap::Outside);    //Within the hole
+  CHECK(prep.classify(Rect(1,3,3,4).at(0))==Overlap::Boundary);
+  CHECK(prep.classify(Rect(0,3,1,4).at(0))==Overlap::Boundary);     //Shares an edge
+  CHECK(prep.classify(Rect(0.8,0.2,5.2,1.8).at(0))==Overlap::Boundary); //Hole lies inside it
+  CHECK(prep.classify(Rect(0.2,3,1.8,5).at(0).at(0))==Overlap::Inside);    //Lone rings too
+  CHECK(prep.classify(Rect(2,1,3,1.2).at(0).at(0))==Overlap::Outside);
+  CHECK(prep.classify(Rect(0.8,0.2,5.2,1.8).at(0).at(0))==Overlap::Boundary);
+
+  //Wherever a shortcut is taken it agrees with clipping
+  int shortcuts = 0;
+  for(int y=-2;y<14;y++)
+  for(int x=-2;x<14;x++){
+    const auto sq = Rect(x*0.5,y*0.5,x*0.5+0.3,y*0.5+0.3);
+    double area;
+    if(TryIntersectionArea(sq, prep, area)){
+      shortcuts++;
+      CHECK(area==doctest::Approx(ConvexIntersectionArea(sq.at(0).at(0),gc.at(0))));
+    }
+  }
+  CHECK(shortcuts>0);
+
+  //Circles
+  CHECK(prep.classify(Circle(Point2D(1,4),0.5))==Overlap::Inside);
+  CHECK(prep.classify(Circle(Point2D(3,4),0.5))==Overlap::Outside);
+  CHECK(prep.classify(Circle(Point2D(3,4),1.5))==Overlap::Boundary);
+  CHECK(prep.classify(Circle(Point2D(3,1),5))==Overlap::Boundary);    //Contains the whole U
+  CHECK(IntersectionArea(Circle(Point2D(1,4),0.5),prep)==doctest::Approx(M_PI*0.25));
+  CHECK(IntersectionArea(Circle(Point2D(3,4),0.5),prep)==0);
+  CHECK(IntersectionArea(Circle(Point2D(3,4),1.5),prep)==doctest::Approx(IntersectionArea(Circle(Point2D(3,4),1.5),gc.at(0))));
+
+  //A prepared border keeps its own copy of the geometry and gives the same
+  //scores as one prepared from the original
+  const auto sub = Rect(0.2,3,1.8,5);
+  PreparedPolygon kept;
+  {
+    const auto copy = ReadGeoJSON(ushape);
+    kept = PreparedPolygon(copy.at(0));
+  }
+  CHECK(kept.geometry().size()==1);
+  CHECK(ScoreConvexHullPTB(sub,kept)==doctest::Approx(ScoreConvexHullPTB(sub,prep)));
+  CHECK(ScoreReockPTB(sub,kept)==doctest::Approx(ScoreReockPTB(sub,prep)));
+  CHECK(ScoreReockPTB(Rect(1,3,3,4),kept)==doctest::Approx(ScoreReockPTB(Rect(1,3,3,4),prep)));
+}
+
+TEST_CASE("Assign points to polygons"){
+  //The U-shape with a hole in its base, and a square overlapping its right arm
+  GeoCollection gc = ReadGeoJSON("{\"type\":\"Polygon\",\"coordinates\":[[[0,0],[6,0],[6,6],[4,6],[4,2],[2,2],[2,6],[0,6],[0,0]],[[1,0.5],[5,0.5],[5,1.5],[1,1.5],[1,0.5]]]}");
+  gc.push_back(Rect(5,3,8,5));
+
+  const auto owners = AssignPointsToPolygons(Points{{0.5,3},{3,3},{3,1},{5.5,4},{7,4},{9,9}}, gc);
+  CHECK(owners==std::vector<unsigned int>{0,NO_FEATURE,NO_FEATURE,0,1,NO_FEATURE});
+
+  //Enough unit squares for a grid to index them
+  const auto grid = UnitSquareGrid(40,40);
+  Points pts;
+  for(int i=0;i<5000;i++)
+    pts.emplace_back(-1+42*((i*7919)%5000+0.37)/5000., -1+42*((i*104729)%4999+0.37)/4999.);
+  const auto grid_owners = AssignPointsToPolygons(pts, grid);
+  REQUIRE(grid_owners.size()==pts.size());
+  for(unsigned int i=0;i<pts.size();i++){
+    const auto &p = pts[i];
+    if(p.x<0 || p.y<0 || p.x>=40 || p.y>=40)
+      CHECK(grid_owners[i]==NO_FEATURE);
+    else
+      CHECK(grid_owners[i]==(unsigned int)(std::floor(p.y)*40+std::floor(p.x)));
+  }
+}
+
+TEST_CASE("Neighbouring districts"){
+  //A 3x3 grid of unit squares plus one square far away from the rest
+  auto gc = UnitSquareGrid(3,3);
+  gc.push_back(Rect(10,10,11,11));
+
+  FindNeighbouringDistricts(gc, 0.01, 0.1, 0.05);
+
+  //Squares touching only at a corner count as neighbours
+  CHECK(gc.at(4).neighbours.size()==8);
+  CHECK(gc.at(0).neighbours.size()==3);
+  CHECK(gc.at(1).neighbours.size()==5);
+  CHECK(gc.at(9).neighbours.empty());
+  CHECK(gc.at(4).props.at("NEIGHNUM")=="8");
+}
+
+TEST_CASE("Parent overlap"){
+  //A 3x3 grid of unit squares inside a single 3x3 square
+  auto subunits = UnitSquareGrid(3,3);
+  GeoCollection superunits;
+  superunits.push_back(Rect(0,0,3,3));
+  subunits.clipperify();
+  superunits.clipperify();
+
+  CalcParentOverlap(subunits, superunits, 0.97, 0.03, 0.1, 0.01);
+
+  for(const auto &sub: subunits){
+    REQUIRE(sub.parents.size()==1);
+    CHECK(sub.parents.at(0).first==0);
+  }
+  CHECK(superunits.at(0).children.size()==9);
+
+  //Only the centre square is away from the superunit's border
+  for(unsigned int i=0;i<subunits.size();i++)
+    CHECK(subunits.at(i).props.at("EXTCHILD")==(i==4?"F":"T"));
+
+  //A subunit straddling the border between two superunits has both as parents
+  GeoCollection straddlers, halves;
+  straddlers.push_back(Rect(2.5,1,3.5,2));
+  straddlers.push_back(Rect(1,1,2,2));
+  halves.push_back(Rect(0,0,3,3));
+  halves.push_back(Rect(3,0,6,3));
+  straddlers.clipperify();
+  halves.clipperify();
+
+  CalcParentOverlap(straddlers, halves, 0.97, 0.03, 0.1, 0.01);
+
+  REQUIRE(straddlers.at(0).parents.size()==2);
+  CHECK(straddlers.at(0).parents.at(0).second==doctest::Approx(0.5));
+  CHECK(straddlers.at(0).parents.at(1).second==doctest::Approx(0.5));
+  REQUIRE(straddlers.at(1).parents.size()==1);
+  CHECK(straddlers.at(1).parents.at(0).first==0);
+}
+
+TEST_CASE("Topological neighbours"){
+  //A 3x3 grid of unit squares
+  auto gc = UnitSquareGrid(3,3);
+
+  auto rook = FindTopologicalNeighbours(gc, Contiguity::Rook);
+  CHECK(rook.size()==12);
+  CHECK(gc.at(4).neighbours==std::vector<unsigned int>{1,3,5,7});
+  CHECK(gc.at(0).props.at("NEIGHBOURS")=="1,3");
+  for(const auto &adj: rook){
+    CHECK(adj.a<adj.b);
+    CHECK(adj.shared_length==doctest::Approx(1));
+  }
+
+  const auto queen = FindTopologicalNeighbours(gc, Contiguity::Queen);
+  CHECK(queen.size()==12+8);
+  CHECK(gc.at(4).neighbours.size()==8);
+  for(const auto &adj: queen)
+    if(adj.a==0 && adj.b==4)
+      CHECK(adj.shared_length==0);
+
+  //Coordinates which differ by less than the snapping distance still match
+  //Nudge the corner of square 1 which it shares with square 0. This also moves
+  //the ring's closing point.
+  gc.at(1).at(0).at(0).at(0).x += 1e-9;
+  gc.at(1).at(0).at(0).back().x += 1e-9;
+  CHECK(FindTopologicalNeighbours(gc, Contiguity::Rook).size()==11);
+  CHECK(FindTopologicalNeighbours(gc, Contiguity::Rook, 1e-6).size()==12);
+}
+
 TEST_CASE("Name lenth"){
   //Score names can't exceed 10 characters due to shapefile limitations
   for(auto &sn: getListOfUnboundedScores())
@@ -104,6 +593,8 @@ TEST_CASE("Intersection area: big square and little square"){
 
   auto gca = ReadGeoJSON(inita);
   auto gcb = ReadGeoJSON(initb);
+  gca.clipperify();
+  gcb.clipperify();
 
   SUBCASE("Area forward"){
     CHECK(IntersectionArea(gca[0],gcb[0])==4);
@@ -112,6 +603,8 @@ TEST_CASE("Intersection area: big square and little square"){
   SUBCASE("Area backward"){
     gca.reverse();
     gcb.reverse();
+    gca.clipperify();
+    gcb.clipperify();
     CHECK(IntersectionArea(gca[0],gcb[0])==4);
   }
 }
@@ -122,16 +615,20 @@ TEST_CASE("Intersection areas big square with hole and little square"){
 
   auto gca = ReadGeoJSON(inita);
   auto gcb = ReadGeoJSON(initb);
+  gca.clipperify();
+  gcb.clipperify();
 
   SUBCASE("Area forward"){
     CHECK(IntersectionArea(gca[0],gcb[0])==1);
   }
 
-  //This should give the same answer as the foregoing since the underlying
-  //clipper library will orientate things correctly for itself
+  //This should give the same answer as the foregoing since the intersection
+  //kernel will orientate things correctly for itself
   SUBCASE("Area backward"){
     gca.reverse();
     gcb.reverse();
+    gca.clipperify();
+    gcb.clipperify();
     CHECK(IntersectionArea(gca[0],gcb[0])==1);
   }
 }
@@ -143,6 +640,8 @@ TEST_CASE("Polygon with hole"){
 
   auto gca = ReadGeoJSON(inita);
   auto gcb = ReadGeoJSON(initb);
+  gca.clipperify();
+  gcb.clipperify();
 
   CHECK(areaIncludingHoles(gca[0])==16);
   CHECK(areaIncludingHoles(gcb[0])==4);
@@ -150,6 +649,94 @@ TEST_CASE("Polygon with hole"){
   CHECK(IntersectionArea(gca[0],gcb[0])==3);
 }
 
+TEST_CASE("Intersection area with shared edges"){
+  CHECK(IntersectionArea(Rect(0,0,2,2),Rect(0,0,2,2))==4);     //Identical
+  CHECK(IntersectionArea(Rect(0,0,2,2),Rect(2,0,4,2))==0);     //Neighbours sharing an edge
+  CHECK(IntersectionArea(Rect(0,0,2,2),Rect(2,2,4,4))==0);     //Touching at a corner
+  CHECK(IntersectionArea(Rect(0,0,2,2),Rect(0,0,1,2))==2);     //Inside, along three edges
+  CHECK(IntersectionArea(Rect(0,0,2,2),Rect(1,0,3,1))==1);     //Overlapping along part of an edge
+  CHECK(IntersectionArea(Rect(0,0,4,4),Rect(1,1,2,3))==2);     //Strictly inside
+  CHECK(IntersectionArea(Rect(0,0,1,1),Rect(5,5,6,6))==0);
+
+  //Against the U-shape with a hole, agreeing with the convex clipper
+  const auto gc = ReadGeoJSON("{\"type\":\"Polygon\",\"coordinates\":[[[0,0],[6,0],[6,6],[4,6],[4,2],[2,2],[2,6],[0,6],[0,0]],[[1,0.5],[5,0.5],[5,1.5],[1,1.5],[1,0.5]]]}");
+  for(int y=-1;y<7;y++)
+  for(int x=-1;x<7;x++){
+    const auto sq = Rect(x*0.75,y*0.75,x*0.75+1.5,y*0.75+1.5);
+    CHECK(IntersectionArea(sq,gc.at(0))==doctest::Approx(ConvexIntersectionArea(sq.at(0).at(0),gc.at(0))));
+    CHECK(IntersectionArea(gc.at(0),sq)==doctest::Approx(ConvexIntersectionArea(sq.at(0).at(0),gc.at(0))));
+  }
+  CHECK(IntersectionArea(gc.at(0),gc.at(0))==doctest::Approx(areaExcludingHoles(gc.at(0))));
+}
+
+TEST_CASE("Partition overlay"){
+  //A 3x3 grid of unit squares, numbered row by row
+  const auto subunits = UnitSquareGrid(3,3);
+
+  SUBCASE("Superunits cutting through subunits"){
+    GeoCollection superunits;
+    superunits.push_back(Rect(0,0,1.5,3));
+    superunits.push_back(Rect(1.5,0,3,3));
+    const auto overlay = PartitionOverlay(subunits, superunits);
+    REQUIRE(overlay.size()==12);
+    std::map<std::pair<unsigned int,unsigned int>, double> areas;
+    for(const auto &o: overlay)
+      areas[std::make_pair(o.sub,o.sup)] = o.area;
+    for(unsigned int row=0;row<3;row++){
+      CHECK(areas[std::make_pair(3*row+0,0u)]==doctest::Approx(1));
+      CHECK(areas[std::make_pair(3*row+1,0u)]==doctest::Approx(0.5));
+      CHECK(areas[std::make_pair(3*row+1,1u)]==doctest::Approx(0.5));
+      CHECK(areas[std::make_pair(3*row+2,1u)]==doctest::Approx(1));
+    }
+    for(unsigned int i=1;i<overlay.size();i++)
+      CHECK((overlay[i-1].sub<overlay[i].sub || (overlay[i-1].sub==overlay[i].sub && overlay[i-1].sup<overlay[i].sup)));
+  }
+
+  SUBCASE("Superunits sharing borders with subunits, with a gap"){
+    GeoCollection superunits;
+    superunits.push_back(Rect(0,0,1,3));
+    superunits.push_back(Rect(1,0,3,2));
+    const auto overlay = PartitionOverlay(subunits, superunits);
+    REQUIRE(overlay.size()==7);
+    for(const auto &o: overlay){
+      CHECK(o.area==doctest::Approx(1));
+      CHECK(o.sup==(o.sub%3==0 ? 0u : 1u));
+    }
+  }
+
+  SUBCASE("Agrees with convex clipping"){
+    //Districts against a coarse grid of squares covering them
+    const auto districts = ReadShapefile("test_data/cb_2015_us_cd114_20m.shp");
+    BoundingBox bb;
+    for(const auto &d: districts){
+      const auto dbb = d.bbox();
+      bb.xmin() = std::min(bb.xmin(),dbb.xmin());
+      bb.ymin() = std::min(bb.ymin(),dbb.ymin());
+      bb.xmax() = std::max(bb.xmax(),dbb.xmax());
+      bb.ymax() = std::max(bb.ymax(),dbb.ymax());
+    }
+    const int n = 12;
+    const double w = (bb.xmax()-bb.xmin())/n;
+    const double h = (bb.ymax()-bb.ymin())/n;
+    GeoCollection cells;
+    for(int y=0;y<n;y++)
+    for(int x=0;x<n;x++)
+      cells.push_back(Rect(bb.xmin()+x*w, bb.ymin()+y*h, bb.xmin()+(x+1)*w, bb.ymin()+(y+1)*h));
+
+    const auto overlay = PartitionOverlay(districts, cells);
+    std::vector<double> district_area(districts.size(), 0);
+    //The cells are convex, so clipping the districts against them gives each
+    //area independently of the overlay's edge splitting
+    for(const auto &o: overlay){
+      district_area[o.sub] += o.area;
+      const auto &cell = cells[o.sup];
+      CHECK(o.area==doctest::Approx(ConvexIntersectionArea(cell.at(0).at(0),districts[o.sub])).epsilon(1e-6));
+    }
+    for(unsigned int d=0;d<districts.size();d++)
+      CHECK(district_area[d]==doctest::Approx(areaExcludingHoles(districts[d])).epsilon(1e-6));
+  }
+}
+
 TEST_CASE("WKT output"){
   const std::string inita = "{\"type\":\"FeatureCollection\",\"features\":[{\"type\":\"Feature\",\"properties\":{},\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[[[0,0],[4,0],[4,4],[0,4],[0,0]],[[1,1],[2,1],[2,2],[1,2],[1,1]]]}}]}";
   const auto gca = ReadGeoJSON(inita);
@@ -164,30 +751,298 @@ TEST_CASE("WKT output"){
 
 
 TEST_CASE("SpIndex"){
+  const auto at = [](const SpIndex &sp, const double x, const double y){
+    return sp.query(BoundingBox(x,y,x,y));
+  };
+
   SpIndex sp;
-  int id=0;
+  unsigned int id=0;
   for(double y=0;y<1000;y+=100)
   for(double x=0;x<1000;x+=100)
-    sp.addBox(x,y,x+100,y+100,id++);
-
-  CHECK(sp.queryPoint(Point2D(350,350))==33);
-  CHECK(sp.queryPoint(Point2D(750,550))==57);
+    sp.insertDeferred(id++, BoundingBox(x,y,x+100,y+100));
+  sp.buildIndex();
 
-  Polygon p;
-  p.exterior.emplace_back(1200,1200);
-  p.exterior.emplace_back(1200,1300);
-  p.exterior.emplace_back(1300,1300);
-  p.exterior.emplace_back(1300,1200);
+  CHECK(at(sp,350,350)==std::vector<unsigned int>{33});
+  CHECK(at(sp,750,550)==std::vector<unsigned int>{57});
+  //Boxes which only touch the query still count
+  CHECK(at(sp,100,50).size()==2);
 
-  AddPolygonToSpIndex(p, sp, 347);
+  const std::string square = "{\"type\":\"Polygon\",\"coordinates\":[[[1200,1200],[1200,1300],[1300,1300],[1300,1200],[1200,1200]]]}";
+  const auto gc = ReadGeoJSON(square);
+  AddToSpIndex(gc.at(0), sp, 347, 0);
   sp.buildIndex();
 
-  CHECK(sp.queryPoint(Point2D(1250,1270))==347);
-  CHECK(sp.queryPoint(Point2D(2750,3379))==-1);
+  CHECK(at(sp,1250,1270)==std::vector<unsigned int>{347});
+  CHECK(at(sp,2750,3379).empty());
+  CHECK(sp.query(gc.at(0))==std::vector<unsigned int>{347});
+
+  //Point-in-polygon on the same square
+  const PointInPolygonIndex pip(gc.at(0));
+  CHECK(pip.contains(Point2D(1250,1270)));
+  CHECK(pip.contains(Point2D(1243,1222)));
+  CHECK(!pip.contains(Point2D(1194,1222)));
+  const PreparedPolygon prep(gc.at(0));
+  CHECK(prep.containsPoint(Point2D(1250,1270)));
+  CHECK(prep.containsPoint(Point2D(1243,1222)));
+  CHECK(!prep.containsPoint(Point2D(1194,1222)));
+  CHECK(AssignPointsToPolygons(Points{{1250,1270},{1243,1222},{1194,1222}}, gc)==std::vector<unsigned int>{0,0,NO_FEATURE});
+
+  //Compare against brute force on many randomly placed boxes
+  idbb boxes;
+  for(unsigned int i=0;i<5000;i++){
+    const double x = std::fmod(i*7919.0,1000.0);
+    const double y = std::fmod(i*104729.0,997.0);
+    const double w = 1+std::fmod(i*31.0,17.0);
+    boxes.emplace_back(i, BoundingBox(x,y,x+w,y+w));
+  }
+  const SpIndex rsp(boxes);
+  for(unsigned int q=0;q<50;q++){
+    const BoundingBox qbb(q*20.0, q*19.0, q*20.0+40, q*19.0+25);
+    auto found = rsp.query(qbb);
+    std::sort(found.begin(),found.end());
+    std::vector<unsigned int> expected;
+    for(const auto &b: boxes)
+      if(b.second.xmin()<=qbb.xmax() && qbb.xmin()<=b.second.xmax() && b.second.ymin()<=qbb.ymax() && qbb.ymin()<=b.second.ymax())
+        expected.push_back(b.first);
+    CHECK(found==expected);
+  }
+
+  //Callback, scratch-buffer, and batch queries all agree with plain queries
+  std::vector<BoundingBox> qbbs;
+  for(unsigned int q=0;q<200;q++)
+    qbbs.emplace_back(std::fmod(q*37.0,990.0), std::fmod(q*53.0,980.0), std::fmod(q*37.0,990.0)+30, std::fmod(q*53.0,980.0)+30);
+  const auto batch = rsp.queryBatch(qbbs);
+  REQUIRE(batch.size()==qbbs.size());
+  std::vector<unsigned int> scratch;
+  for(unsigned int q=0;q<qbbs.size();q++){
+    auto expected = rsp.query(qbbs[q]);
+    std::sort(expected.begin(),expected.end());
+
+    std::vector<unsigned int> from_batch(batch.begin(q),batch.end(q));
+    std::sort(from_batch.begin(),from_batch.end());
+    CHECK(from_batch==expected);
+
+    rsp.query(qbbs[q], scratch);
+    std::sort(scratch.begin(),scratch.end());
+    CHECK(scratch==expected);
+
+    unsigned int count = 0;
+    rsp.query(qbbs[q], [&](const unsigned int){ count++; });
+    CHECK(count==expected.size());
+  }
+
+  //A join finds the same pairs as querying one index with every box of the other
+  idbb qboxes;
+  for(unsigned int q=0;q<qbbs.size();q++)
+    qboxes.emplace_back(q,qbbs[q]);
+  const auto joined = SpatialJoin(SpIndex(qboxes), rsp);
+  std::vector< std::pair<unsigned int, unsigned int> > probed;
+  for(unsigned int q=0;q<qbbs.size();q++)
+  for(unsigned int b=batch.offsets[q];b<batch.offsets[q+1];b++)
+    probed.emplace_back(q,batch.ids[b]);
+  std::sort(probed.begin(),probed.end());
+  CHECK(joined==probed);
+}
+
+TEST_CASE("Bulk loading"){
+  //Large enough that keys are sorted in parallel pieces (the tests are built
+  //with OpenMP)
+  std::vector<uint64_t> v;
+  for(uint64_t i=0;i<300000;i++)
+    v.push_back((i*2654435761u)%1000003);
+  auto expected = v;
+  std::sort(expected.begin(),expected.end());
+  ParallelSort(v);
+  CHECK(v==expected);
+
+  idbb boxes;
+  for(unsigned int i=0;i<200000;i++){
+    const double x = std::fmod(i*7919.0,10000.0);
+    const double y = std::fmod(i*104729.0,9973.0);
+    boxes.emplace_back(i, BoundingBox(x,y,x+3,y+3));
+  }
+  const SpIndex sp(boxes);
+  for(unsigned int q=0;q<20;q++){
+    const BoundingBox qbb(q*500.0, q*450.0, q*500.0+60, q*450.0+60);
+    auto found = sp.query(qbb);
+    std::sort(found.begin(),found.end());
+    std::vector<unsigned int> expected_ids;
+    for(const auto &b: boxes)
+      if(b.second.xmin()<=qbb.xmax() && qbb.xmin()<=b.second.xmax() && b.second.ymin()<=qbb.ymax() && qbb.ymin()<=b.second.ymax())
+        expected_ids.push_back(b.first);
+    CHECK(found==expected_ids);
+  }
+}
+
+TEST_CASE("Grid index"){
+  //Similar-sized boxes, some degenerate, some sharing corners
+  idbb boxes;
+  for(unsigned int i=0;i<4000;i++){
+    const double x = std::fmod(i*7919.0,1000.0);
+    const double y = std::fmod(i*104729.0,997.0);
+    const double w = (i%10==0) ? 0 : 2+std::fmod(i*31.0,5.0);
+    boxes.emplace_back(i, BoundingBox(x,y,x+w,y+w));
+  }
+  const GridIndex gi(boxes);
+  const SpIndex   sp(boxes);
+  CHECK(sp.usesGrid());
+  CHECK(UniformGrid::Suits(boxes));
+  const auto suited = UniformGrid::BuildIfSuited(boxes);
+  REQUIRE(suited);
+  CHECK(suited->size()==boxes.size());
+  //A few huge boxes among the small ones spoil the fit
+  auto mixed = boxes;
+  for(unsigned int i=0;i<200;i++)
+    mixed.emplace_back(5000+i, BoundingBox(0,0,900,900));
+  CHECK(!UniformGrid::Suits(mixed));
+  CHECK(!UniformGrid::BuildIfSuited(mixed));
+
+  for(unsigned int q=0;q<60;q++){
+    const BoundingBox qbb(q*17.0-30, q*16.0-20, q*17.0+10, q*16.0+35);
+    std::vector<unsigned int> expected;
+    for(const auto &b: boxes)
+      if(b.second.xmin()<=qbb.xmax() && qbb.xmin()<=b.second.xmax() && b.second.ymin()<=qbb.ymax() && qbb.ymin()<=b.second.ymax())
+        expected.push_back(b.first);
+    auto from_grid = gi.query(qbb);
+    std::sort(from_grid.begin(),from_grid.end());
+    CHECK(from_grid==expected);
+    auto from_sp = sp.query(qbb);
+    std::sort(from_sp.begin(),from_sp.end());
+    CHECK(from_sp==expected);
+  }
+
+  //Queries can extend past the grid, or miss it entirely
+  CHECK(gi.query(BoundingBox(-1e6,-1e6,1e6,1e6)).size()==boxes.size());
+  CHECK(gi.query(BoundingBox(5000,5000,5001,5001)).empty());
+
+  //Joins involving a grid fall back to probing, with the same results
+  idbb few;
+  for(unsigned int q=0;q<30;q++)
+    few.emplace_back(q, BoundingBox(q*30.0, q*29.0, q*30.0+20, q*29.0+20));
+  const SpIndex fsp(few);
+  CHECK(!fsp.usesGrid());
+  const auto joined = SpatialJoin(fsp, sp);
+  std::vector< std::pair<unsigned int, unsigned int> > probed;
+  for(const auto &f: few)
+  for(const auto &b: boxes)
+    if(b.second.xmin()<=f.second.xmax() && f.second.xmin()<=b.second.xmax() && b.second.ymin()<=f.second.ymax() && f.second.ymin()<=b.second.ymax())
+      probed.emplace_back(f.first,b.first);
+  CHECK(joined==probed);
+}
+
+TEST_CASE("Saved spatial indices"){
+  //Sizes vary widely so that a tree is used, rather than a grid
+  idbb boxes;
+  for(unsigned int i=0;i<3000;i++){
+    const double x = std::fmod(i*7919.0,1000.0);
+    const double y = std::fmod(i*104729.0,997.0);
+    const double w = (i%100==0) ? 500 : 5;
+    boxes.emplace_back(i, BoundingBox(x,y,x+w,y+w));
+  }
+  const SpIndex sp(boxes);
+  CHECK(!sp.usesGrid());
+  const BoundingBox qbb(100,100,200,180);
+  auto expected = sp.query(qbb);
+  std::sort(expected.begin(),expected.end());
+
+  const auto sorted_query = [&](const SpIndex &idx){
+    auto found = idx.query(qbb);
+    std::sort(found.begin(),found.end());
+    return found;
+  };
+
+  sp.save("spindex_test.bin");
+  auto loaded = SpIndex::load("spindex_test.bin");
+  CHECK(sorted_query(loaded)==expected);
+  //Boxes added later join those from the file
+  loaded.insert(9999, BoundingBox(150,150,151,151));
+  auto with_new = expected;
+  with_new.push_back(9999);
+  CHECK(sorted_query(loaded)==with_new);
+
+  //Damaged files are rejected
+  std::vector<char> intact;
+  {
+    std::ifstream fin("spindex_test.bin", std::ios::binary);
+    intact.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+  }
+  const auto load_damaged = [&](const size_t offset, const void *data, const size_t len){
+    auto damaged = intact;
+    std::memcpy(damaged.data()+offset, data, len);
+    std::ofstream("spindex_test.bin", std::ios::binary).write(damaged.data(), damaged.size());
+    return SpIndex::load("spindex_test.bin");
+  };
+  const uint32_t bad_node_size = 99;
+  CHECK_THROWS(load_damaged(12, &bad_node_size, sizeof(bad_node_size)));
+  //Header layout: node count at 24, level count at 32, then the level ends
+  uint64_t num_nodes, num_levels, leaves;
+  std::memcpy(&num_nodes,  intact.data()+24, sizeof(uint64_t));
+  std::memcpy(&num_levels, intact.data()+32, sizeof(uint64_t));
+  std::memcpy(&leaves,     intact.data()+48, sizeof(uint64_t));
+  REQUIRE(num_levels>=3);
+  const uint64_t too_many_levels = 1000000;
+  CHECK_THROWS(load_damaged(32, &too_many_levels, sizeof(uint64_t)));
+  //Counts chosen so that the file's length works out only if the offsets
+  //wrap around
+  const uint64_t wrapping_nodes = num_nodes + (1ull<<62);
+  CHECK_THROWS(load_damaged(24, &wrapping_nodes, sizeof(uint64_t)));
+  const uint64_t shrunk_level = leaves-1;
+  CHECK_THROWS(load_damaged(48+8, &shrunk_level, sizeof(uint64_t)));
+  const size_t ids_off = 48 + num_levels*sizeof(uint64_t) + num_nodes*sizeof(BoundingBox);
+  const unsigned int bad_child = num_nodes+5;
+  CHECK_THROWS(load_damaged(ids_off+leaves*sizeof(unsigned int), &bad_child, sizeof(bad_child)));
+  //Leaf ids are the caller's own and may be anything
+  CHECK_NOTHROW(load_damaged(ids_off, &bad_child, sizeof(bad_child)));
+  std::remove("spindex_test.bin");
+
+  //With a cache directory the first build saves the index and the second maps it
+  SetSpIndexCacheDir(".");
+  char hashstr[17];
+  std::snprintf(hashstr, sizeof(hashstr), "%016llx", (unsigned long long)HashBoxes(boxes));
+  const std::string cached = std::string("./spindex-") + hashstr + ".bin";
+  const SpIndex first(boxes);
+  CHECK(std::ifstream(cached).good());
+  const SpIndex second(boxes);
+  CHECK(sorted_query(first)==expected);
+  CHECK(sorted_query(second)==expected);
+
+  //A file named for these boxes but built from others (a stale file, or a hash
+  //collision) is not trusted, but rebuilt
+  idbb others;
+  for(const auto &b: boxes)
+    if(b.first!=expected.front())
+      others.push_back(b);
+  SetSpIndexCacheDir("");
+  SpIndex(others).save(cached);
+  SetSpIndexCacheDir(".");
+  {
+    std::fstream forged(cached, std::ios::binary | std::ios::in | std::ios::out);
+    const uint64_t hash = HashBoxes(boxes);
+    forged.seekp(16);
+    forged.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+  }
+  CHECK(sorted_query(SpIndex::load(cached))!=expected);
+  const SpIndex third(boxes);
+  CHECK(sorted_query(third)==expected);
+  CHECK(sorted_query(SpIndex::load(cached))==expected); //Replaced by the rebuilt index
+  SetSpIndexCacheDir("");
+  std::remove(cached.c_str());
+}
+
+TEST_CASE("Spatial join of collections"){
+  //A 3x3 grid of unit squares joined against a 2x2 square covering the
+  //bottom-left four of them (and touching five more)
+  const auto grid = UnitSquareGrid(3,3);
+  GeoCollection big;
+  big.push_back(Rect(0,0,2,2));
+
+  const auto pairs = SpatialJoin(grid, big);
+  CHECK(pairs.size()==9);
+  CHECK(pairs.front()==std::make_pair(0u,0u));
 
-  CHECK(p.containsPoint(Point2D(1250,1270)));
-  CHECK(p.containsPoint(Point2D(1243,1222)));
-  CHECK(!p.containsPoint(Point2D(1194,1222)));
+  //Each square overlaps itself and the squares around it
+  const auto self = SpatialJoin(grid, grid);
+  CHECK(self.size()==9+2*(6+6+4+4));
 }
 
 
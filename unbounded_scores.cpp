@@ -3,6 +3,7 @@
 #include <cmath>
 #include <vector>
 #include <stdexcept>
+#include <exception>
 
 namespace complib {
 
@@ -45,7 +46,7 @@ double ScoreReockPS(const MultiPolygon &mp){
   const double area = areaIncludingHoles(mp);
   double circ_area  = 0;
   for(const auto &poly: mp)
-    circ_area += M_PI*std::pow(diameterOuter(poly)/2.0,2.0);
+    circ_area += MinimumEnclosingCircle(poly.at(0)).area();
 
   return area/circ_area;
 }
@@ -60,20 +61,53 @@ void CalculateListOfUnboundedScores(GeoCollection &gc, std::vector<std::string>
   else if(score_list.size()==1 && score_list.at(0)=="all")
     score_list = getListOfUnboundedScores();
 
-  for(unsigned int i=0;i<gc.size();i++){
-    for(const auto &sn: score_list){
-      if(unbounded_score_map.count(sn))
-        gc[i].scores[sn] = unbounded_score_map.at(sn)(gc[i]);
+  //Drop unknown scores so that every (feature, score) pair is real work
+  std::vector<const unbounded_score_map_t::mapped_type*> score_fns;
+  std::vector<std::string> score_names;
+  for(const auto &sn: score_list){
+    if(unbounded_score_map.count(sn)){
+      score_fns.push_back(&unbounded_score_map.at(sn));
+      score_names.push_back(sn);
     }
   }
+
+  //Features' cached geometry is safe to share between threads, so features and
+  //the scores of each feature can all be calculated in parallel. Results go
+  //into a flat buffer since the features' score maps are not thread-safe.
+  const int nfeat   = gc.size();
+  const int nscores = score_fns.size();
+  std::vector<double> results(nfeat*nscores);
+
+  std::exception_ptr error;
+
+  #pragma omp parallel for collapse(2) schedule(dynamic)
+  for(int i=0;i<nfeat;i++)
+  for(int s=0;s<nscores;s++){
+    //Exceptions can't leave a parallel region, so hold on to the first one
+    try {
+      results[i*nscores+s] = (*score_fns[s])(gc[i]);
+    } catch (...) {
+      #pragma omp critical
+      if(!error)
+        error = std::current_exception();
+    }
+  }
+
+  if(error)
+    std::rethrow_exception(error);
+
+  for(int i=0;i<nfeat;i++)
+  for(int s=0;s<nscores;s++)
+    gc[i].scores[score_names[s]] = results[i*nscores+s];
 }
 
 const std::vector<std::string>& getListOfUnboundedScores(){
-  static std::vector<std::string> score_names;
-  if(!score_names.empty())
-    return score_names;
-  for(const auto &kv: unbounded_score_map)
-    score_names.push_back(kv.first);
+  static const std::vector<std::string> score_names = [](){
+    std::vector<std::string> temp;
+    for(const auto &kv: unbounded_score_map)
+      temp.push_back(kv.first);
+    return temp;
+  }();
   return score_names;
 }
 
@@ -7,6 +7,7 @@
 #include <sstream>
 #include <iomanip>
 #include <string>
+#include <utility>
 
 namespace complib {
 
@@ -46,9 +47,8 @@ Point2D ParsePoint(size_t &start, const std::string &wktstr){
 
 
 
-Ring ParseRing(size_t &start, const std::string &wktstr){
-  Ring ring;
-
+template<class Builder>
+static void ParseRing(size_t &start, const std::string &wktstr, Builder &fc){
   if(wktstr[start]!='(')
     throw std::runtime_error(std::string("Ring: Expected '(' found '")+wktstr[start]+"'!");
   TrimStr(++start, wktstr);
@@ -61,17 +61,18 @@ Ring ParseRing(size_t &start, const std::string &wktstr){
       start++;
       break;
     } else {
-      ring.emplace_back(ParsePoint(start,wktstr));
+      const auto pt = ParsePoint(start,wktstr);
+      fc.addPoint(pt.x, pt.y);
     }
   }
 
-  return ring;
+  fc.endRing();
 }
 
 
 
-Polygon ParsePolygon(size_t &start, const std::string &wktstr){
-  Polygon poly;
+template<class Builder>
+static void ParsePolygon(size_t &start, const std::string &wktstr, Builder &fc){
   if(wktstr[start]!='(')
     throw std::runtime_error(std::string("Polygon: Expected '(' found '")+wktstr[start]+"'!");
   TrimStr(++start, wktstr);
@@ -80,7 +81,7 @@ Polygon ParsePolygon(size_t &start, const std::string &wktstr){
     TrimStr(start,wktstr);
     if(wktstr[start]=='('){
       //First ring is the outer ring, all the others are holes
-      poly.emplace_back(ParseRing(start,wktstr));
+      ParseRing(start,wktstr,fc);
     } else if(wktstr[start]==','){
       TrimStr(++start, wktstr); //Move forward from ',' and skip whitespace
     } else if(wktstr[start]==')'){
@@ -89,22 +90,21 @@ Polygon ParsePolygon(size_t &start, const std::string &wktstr){
     }
   }
 
-  return poly;
+  fc.endPolygon();
 }
 
 
 
-MultiPolygon ParseTopPolygon(size_t start, const std::string &wktstr){
-  MultiPolygon mps;
+template<class Builder>
+static void ParseTopPolygon(size_t start, const std::string &wktstr, Builder &fc){
   TrimStr(start,wktstr);
-  mps.push_back(ParsePolygon(start,wktstr));
-  return mps;
+  ParsePolygon(start,wktstr,fc);
 }
 
 
 
-MultiPolygon ParseMultiPolygon(size_t start, const std::string &wktstr){
-  MultiPolygon mps;
+template<class Builder>
+static void ParseMultiPolygon(size_t start, const std::string &wktstr, Builder &fc){
   TrimStr(start,wktstr);
   if(wktstr[start]!='(')
     throw std::runtime_error(std::string("MultiPolygon: Expected '(' found '")+wktstr[start]+"'!");
@@ -113,7 +113,7 @@ MultiPolygon ParseMultiPolygon(size_t start, const std::string &wktstr){
   while(true){
     TrimStr(start,wktstr);
     if(wktstr[start]=='('){
-      mps.emplace_back(ParsePolygon(start,wktstr));
+      ParsePolygon(start,wktstr,fc);
     } else if(wktstr[start]==','){
       TrimStr(++start, wktstr); //Move forward from ',' and skip whitespace
     } else if(wktstr[start]==')'){
@@ -121,30 +121,41 @@ MultiPolygon ParseMultiPolygon(size_t start, const std::string &wktstr){
       break;
     }
   }
-
-  return mps;
 }
 
 
 
-GeoCollection ReadWKT(std::string wktstr){
-  GeoCollection gc;
-
+//Fills `fc` with the single feature of a WKT string. Winding is not corrected.
+template<class Builder>
+static void ParseWKT(const std::string &wktstr, Builder &fc){
   size_t start = 0;
   TrimStr(start,wktstr);
 
   //TODO: Trim string
   if(wktstr.compare(start,12,"MULTIPOLYGON")==0){
-    gc.push_back(ParseMultiPolygon(start+12,wktstr));
+    ParseMultiPolygon(start+12,wktstr,fc);
   } else if(wktstr.compare(start,7,"POLYGON")==0){
-    gc.push_back(ParseTopPolygon(start+7,wktstr));
+    ParseTopPolygon(start+7,wktstr,fc);
   } else{
     throw std::runtime_error("Unrecognized geometry!");
   }
+  fc.endFeature();
+}
 
-  gc.correctWindingDirection();
+FlatGeoCollection ReadWKTFlat(std::string wktstr){
+  FlatGeoCollection fc;
+  ParseWKT(wktstr, fc);
+  fc.correctWindingDirection();
   
-  return gc;
+  return fc;
+}
+
+GeoCollection ReadWKT(std::string wktstr){
+  GeoCollectionBuilder builder;
+  ParseWKT(wktstr, builder);
+  builder.gc.correctWindingDirection();
+
+  return std::move(builder.gc);
 }
 
 GeoCollection ReadWKTFile(std::string filename) {
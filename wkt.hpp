@@ -2,12 +2,14 @@
 #define _wkt_hpp_
 
 #include "geom.hpp"
+#include "flat_geom.hpp"
 #include <string>
 
 namespace complib {
 
   GeoCollection ReadWKT(std::string wktstr);
   GeoCollection ReadWKTFile(std::string filename);
+  FlatGeoCollection ReadWKTFlat(std::string wktstr);
   std::string   GetWKT(const MultiPolygon &mp);
 }
 